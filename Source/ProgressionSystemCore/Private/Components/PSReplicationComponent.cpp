@@ -0,0 +1,353 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Components/PSReplicationComponent.h"
+//---
+#include "Data/PSProgressionOwner.h"
+#include "Data/PSReplicationSubsystem.h"
+#include "Data/PSSaveGameData.h"
+#include "GameFramework/MyPlayerState.h"
+#include "GameFramework/PlayerController.h"
+#include "LevelActors/PlayerCharacter.h"
+#include "Net/UnrealNetwork.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PSReplicationComponent)
+
+// Is called on clients when the row is received for the first time
+void FPSReplicatedRow::PostReplicatedAdd(const FPSReplicatedRows& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->OnRowReplicated(*this);
+	}
+}
+
+// Is called on clients when the row is changed by the server
+void FPSReplicatedRow::PostReplicatedChange(const FPSReplicatedRows& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->OnRowReplicated(*this);
+	}
+}
+
+// Returns the index of the row by its name, INDEX_NONE if it's not found
+int32 FPSReplicatedRows::IndexOfRow(FName RowName) const
+{
+	return Items.IndexOfByPredicate([RowName](const FPSReplicatedRow& Row) { return Row.RowName == RowName; });
+}
+
+// Creates rows in the order of settings and fills them with the uploaded progression validated by these settings, rows are not marked dirty here
+void FPSReplicatedRows::SeedRows(const TMap<FName, FPSRowData>& ProgressionSettings, const TArray<FPSReplicatedRow>& SavedRows)
+{
+	Items.Reset(ProgressionSettings.Num());
+	const FPSRowData* PreviousRowSettings = nullptr;
+	for (const TTuple<FName, FPSRowData>& It : ProgressionSettings)
+	{
+		// Rows unknown to the server are skipped, missing rows are locked
+		const FPSReplicatedRow* SavedRow = SavedRows.FindByPredicate([&It](const FPSReplicatedRow& Row) { return Row.RowName == It.Key; });
+		FPSSaveToDiskData SaveToDiskData = SavedRow ? SavedRow->SaveToDiskData : FPSSaveToDiskData::EmptyData;
+		SaveToDiskData.CurrentLevelProgression = FMath::IsFinite(SaveToDiskData.CurrentLevelProgression) ? FMath::Max(SaveToDiskData.CurrentLevelProgression, 0.f) : 0.f;
+
+		// Uploaded rows are validated by the server's settings with the same unlock rule as local saves
+		if (PreviousRowSettings)
+		{
+			const FPSSaveToDiskData& PreviousRow = Items.Last().SaveToDiskData;
+			const bool bCanBeUnlocked = !PreviousRow.IsLevelLocked && UPSSaveGameData::ShouldUnlockNextLevel(*PreviousRowSettings, PreviousRow.CurrentLevelProgression);
+			SaveToDiskData.IsLevelLocked = SaveToDiskData.IsLevelLocked || !bCanBeUnlocked;
+		}
+		else
+		{
+			SaveToDiskData.IsLevelLocked = false;
+		}
+
+		// Points are earned only on unlocked levels
+		if (SaveToDiskData.IsLevelLocked)
+		{
+			SaveToDiskData.CurrentLevelProgression = 0.f;
+		}
+
+		Items.Emplace(It.Key, SaveToDiskData);
+		PreviousRowSettings = &It.Value;
+	}
+}
+
+// Adds the reward to the row and unlocks the next row if enough points are achieved, rows are not marked dirty here
+void FPSReplicatedRows::AddReward(int32 RowIndex, const FPSRowData& RowSettings, float Reward, TArray<int32, TInlineAllocator<2>>& OutChangedRowIndices)
+{
+	if (!Items.IsValidIndex(RowIndex))
+	{
+		return;
+	}
+
+	FPSSaveToDiskData& CurrentRow = Items[RowIndex].SaveToDiskData;
+	CurrentRow.CurrentLevelProgression += Reward;
+	OutChangedRowIndices.Emplace(RowIndex);
+
+	// Unlock the next level, so both rows are sent in the same bunch
+	const int32 NextRowIndex = RowIndex + 1;
+	if (UPSSaveGameData::ShouldUnlockNextLevel(RowSettings, CurrentRow.CurrentLevelProgression)
+		&& Items.IsValidIndex(NextRowIndex)
+		&& Items[NextRowIndex].SaveToDiskData.IsLevelLocked)
+	{
+		Items[NextRowIndex].SaveToDiskData.IsLevelLocked = false;
+		OutChangedRowIndices.Emplace(NextRowIndex);
+	}
+}
+
+// Sets default values for this component's properties
+UPSReplicationComponent::UPSReplicationComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	SetIsReplicatedByDefault(true);
+	ReplicatedRowsInternal.OwnerComponent = this;
+}
+
+// Returns the replicated progression of the level, is empty if the row is not replicated yet
+const FPSSaveToDiskData& UPSReplicationComponent::GetReplicatedRowByName(FName RowName) const
+{
+	const int32 RowIndex = ReplicatedRowsInternal.IndexOfRow(RowName);
+	return ReplicatedRowsInternal.Items.IsValidIndex(RowIndex) ? ReplicatedRowsInternal.Items[RowIndex].SaveToDiskData : FPSSaveToDiskData::EmptyData;
+}
+
+// Returns true if the owning player state belongs to a local player of this game instance
+bool UPSReplicationComponent::IsLocallyOwned() const
+{
+	const APlayerState* PlayerState = Cast<APlayerState>(GetOwner());
+	const APlayerController* PlayerController = PlayerState ? PlayerState->GetPlayerController() : nullptr;
+	return PlayerController && PlayerController->IsLocalController();
+}
+
+// Sends the saved progression of the local player to the server, is called once the save is loaded
+void UPSReplicationComponent::UploadLocalProgression(UPSSaveGameData* SaveGameData)
+{
+	if (bIsSeededInternal
+		|| !ensureMsgf(SaveGameData, TEXT("ASSERT: [%i] %hs:\n'SaveGameData' is null!"), __LINE__, __FUNCTION__))
+	{
+		return;
+	}
+
+	TArray<FPSReplicatedRow> SavedRows;
+	const TMap<FName, FPSSaveToDiskData>& SavedData = SaveGameData->GetProgressionSettingsRowDataInternal();
+	SavedRows.Reserve(SavedData.Num());
+	for (const TTuple<FName, FPSSaveToDiskData>& It : SavedData)
+	{
+		SavedRows.Emplace(It.Key, It.Value);
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		// The listen server player seeds its own rows without the round trip
+		SeedRows(SavedRows);
+	}
+	else
+	{
+		ServerUploadProgression(SavedRows);
+	}
+}
+
+// Is called when the row is changed on the server or received on the client, writes it to the local save if the owner is local
+void UPSReplicationComponent::OnRowReplicated(const FPSReplicatedRow& Row)
+{
+	// The owner might be replicated after the first rows
+	TryRegisterLocally();
+	if (!bIsRegisteredLocallyInternal)
+	{
+		// Rows of other players are only displayed, they are not saved on this machine
+		return;
+	}
+
+	if (IPSProgressionOwner* ProgressionOwner = UPSReplicationSubsystem::GetChecked(*this).GetProgressionOwner())
+	{
+		ProgressionOwner->ApplyReplicatedProgressionRow(this, Row.RowName, Row.SaveToDiskData);
+	}
+}
+
+// Returns properties that are replicated for the lifetime of the actor channel
+void UPSReplicationComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ThisClass, ReplicatedRowsInternal);
+	DOREPLIFETIME(ThisClass, bIsSeededInternal);
+}
+
+// Called when the game starts
+void UPSReplicationComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Only the server applies end-game rewards
+	AMyPlayerState* PlayerState = Cast<AMyPlayerState>(GetOwner());
+	if (PlayerState && GetOwnerRole() == ROLE_Authority)
+	{
+		PlayerState->OnEndGameStateChanged.AddUniqueDynamic(this, &ThisClass::OnEndGameStateChanged);
+	}
+
+	TryRegisterLocally();
+}
+
+// Clears all transient data created by this component
+void UPSReplicationComponent::OnUnregister()
+{
+	if (AMyPlayerState* PlayerState = Cast<AMyPlayerState>(GetOwner()))
+	{
+		PlayerState->OnEndGameStateChanged.RemoveAll(this);
+	}
+
+	const UPSReplicationSubsystem* ReplicationSubsystem = UPSReplicationSubsystem::Get(this);
+	IPSProgressionOwner* ProgressionOwner = ReplicationSubsystem ? ReplicationSubsystem->GetProgressionOwner() : nullptr;
+	if (bIsRegisteredLocallyInternal && ProgressionOwner)
+	{
+		ProgressionOwner->RemoveProgressionReplication(this);
+	}
+	bIsRegisteredLocallyInternal = false;
+
+	Super::OnUnregister();
+}
+
+// Registers this component in the progression owner if the owning player is local, so the server becomes the authority of its progression
+void UPSReplicationComponent::TryRegisterLocally()
+{
+	if (bIsRegisteredLocallyInternal || !IsLocallyOwned())
+	{
+		return;
+	}
+
+	IPSProgressionOwner* ProgressionOwner = UPSReplicationSubsystem::GetChecked(*this).GetProgressionOwner();
+	if (!ProgressionOwner)
+	{
+		// There is no presentation, so there is no local save to write rows to
+		return;
+	}
+
+	bIsRegisteredLocallyInternal = true;
+	ProgressionOwner->SetProgressionReplication(this);
+}
+
+// Validates the uploaded progression, the client is disconnected if it sends more rows than possible
+bool UPSReplicationComponent::ServerUploadProgression_Validate(const TArray<FPSReplicatedRow>& SavedRows)
+{
+	return SavedRows.Num() <= UPSReplicationSubsystem::GetChecked(*this).GetProgressionSettings().Num();
+}
+
+// Receives the saved progression of the owning client, is applied only once
+void UPSReplicationComponent::ServerUploadProgression_Implementation(const TArray<FPSReplicatedRow>& SavedRows)
+{
+	SeedRows(SavedRows);
+}
+
+// Creates rows in the order of the data table and fills them with the uploaded progression
+void UPSReplicationComponent::SeedRows(const TArray<FPSReplicatedRow>& SavedRows)
+{
+	if (bIsSeededInternal)
+	{
+		// The server is the authority since the first upload
+		return;
+	}
+
+	ReplicatedRowsInternal.SeedRows(UPSReplicationSubsystem::GetChecked(*this).GetProgressionSettings(), SavedRows);
+	for (FPSReplicatedRow& Row : ReplicatedRowsInternal.Items)
+	{
+		MarkRowDirty(Row);
+	}
+
+	bIsSeededInternal = true;
+}
+
+// Is called on the server when the end-game state of the owning player is changed
+void UPSReplicationComponent::OnEndGameStateChanged_Implementation(EEndGameState EndGameState)
+{
+	if (EndGameState != EEndGameState::None)
+	{
+		ApplyEndGameReward(EndGameState);
+	}
+	else
+	{
+		MatchProgressInternal = 0.f;
+	}
+}
+
+// Adds the end-game reward and in-match progress to the row of the owning player's character and unlocks the next row if enough points are achieved
+void UPSReplicationComponent::ApplyEndGameReward(EEndGameState EndGameState)
+{
+	const int32 RowIndex = ReplicatedRowsInternal.IndexOfRow(GetOwnerRowName());
+	if (GetOwnerRole() != ROLE_Authority || !bIsSeededInternal || RowIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const UPSReplicationSubsystem& ReplicationSubsystem = UPSReplicationSubsystem::GetChecked(*this);
+	const FPSRowData* RowData = ReplicationSubsystem.GetProgressionSettings().Find(ReplicatedRowsInternal.Items[RowIndex].RowName);
+	if (!ensureMsgf(RowData, TEXT("ASSERT: [%i] %hs:\n'RowData' is null!"), __LINE__, __FUNCTION__))
+	{
+		return;
+	}
+
+	// Same reward and unlock rule as in the local game, in-match progress is committed once together with the reward
+	const float ProgressionReward = UPSSaveGameData::CalculateProgressionReward(*RowData, EndGameState, ReplicationSubsystem.GetRewardMultiplier());
+	const float MatchProgress = MatchProgressInternal;
+	MatchProgressInternal = 0.f;
+	AddRowReward(RowIndex, *RowData, ProgressionReward + MatchProgress);
+}
+
+// Adds points earned by an in-match event of the owning player, they are added together with the end-game reward of the match
+void UPSReplicationComponent::AddMatchProgress(float Points)
+{
+	if (GetOwnerRole() != ROLE_Authority
+		|| !FMath::IsFinite(Points))
+	{
+		return;
+	}
+
+	const float MaxMatchProgress = UPSReplicationSubsystem::GetChecked(*this).GetMaxMatchProgress();
+	MatchProgressInternal = FMath::Clamp(MatchProgressInternal + Points, 0.f, MaxMatchProgress);
+}
+
+// Adds the reward to the row on the server, unlocks the next row if enough points are achieved and marks changed rows to be replicated
+void UPSReplicationComponent::AddRowReward(int32 RowIndex, const FPSRowData& RowSettings, float Reward)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<2>> ChangedRowIndices;
+	ReplicatedRowsInternal.AddReward(RowIndex, RowSettings, Reward, ChangedRowIndices);
+	for (const int32 ChangedRowIndex : ChangedRowIndices)
+	{
+		MarkRowDirty(ReplicatedRowsInternal.Items[ChangedRowIndex]);
+	}
+}
+
+// Returns the progression row of the owning player's character, none if the character is not possessed
+FName UPSReplicationComponent::GetOwnerRowName() const
+{
+	const APlayerState* PlayerState = Cast<APlayerState>(GetOwner());
+	const APlayerCharacter* PlayerCharacter = PlayerState ? PlayerState->GetPawn<APlayerCharacter>() : nullptr;
+	if (!PlayerCharacter)
+	{
+		return NAME_None;
+	}
+
+	const FPlayerTag& PlayerTag = PlayerCharacter->GetPlayerTag();
+	for (const TTuple<FName, FPSRowData>& It : UPSReplicationSubsystem::GetChecked(*this).GetProgressionSettings())
+	{
+		if (It.Value.Character == PlayerTag)
+		{
+			return It.Key;
+		}
+	}
+	return NAME_None;
+}
+
+// Marks the row to be replicated and applies it locally if the owner is the listen server player
+void UPSReplicationComponent::MarkRowDirty(FPSReplicatedRow& Row)
+{
+	INC_DWORD_STAT(STAT_PSReplicatedRowsDirtied);
+	ReplicatedRowsInternal.MarkItemDirty(Row);
+
+	// Replication callbacks are not called on the server
+	OnRowReplicated(Row);
+}
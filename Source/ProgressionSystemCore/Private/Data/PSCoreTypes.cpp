@@ -0,0 +1,11 @@
+﻿// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSCoreTypes.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PSCoreTypes)
+
+DEFINE_LOG_CATEGORY(LogProgressionSystem);
+DEFINE_STAT(STAT_PSReplicatedRowsDirtied);
+
+const FPSRowData FPSRowData::EmptyData = FPSRowData{};
+const FPSSaveToDiskData FPSSaveToDiskData::EmptyData = FPSSaveToDiskData{};
@@ -0,0 +1,119 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSGameInstanceSubsystem.h"
+//---
+#include "Data/PSProgressionOwner.h"
+#include "Data/PSSaveGameData.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "MyDataTable/MyDataTable.h"
+#include "MyUtilsLibraries/GameplayUtilsLibrary.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PSGameInstanceSubsystem)
+
+// Returns the subsystem of the game instance of given object's world, is null if the world has no game instance
+UPSGameInstanceSubsystem* UPSGameInstanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return UGameInstance::GetSubsystem<ThisClass>(World ? World->GetGameInstance() : nullptr);
+}
+
+// Returns settings of all progression rows, are copied from the given data table once per game instance
+const TMap<FName, FPSRowData>& UPSGameInstanceSubsystem::GetOrLoadProgressionSettings(const UDataTable* ProgressionDataTable)
+{
+	if (ProgressionSettingsDataInternal.IsEmpty())
+	{
+		if (ensureMsgf(ProgressionDataTable, TEXT("ASSERT: [%i] %hs:\n'ProgressionDataTable' is not valid!"), __LINE__, __FUNCTION__))
+		{
+			UMyDataTable::GetRows(*ProgressionDataTable, ProgressionSettingsDataInternal);
+		}
+	}
+	return ProgressionSettingsDataInternal;
+}
+
+// Returns the save profile that is already loaded to the given slot in this game instance, is null if it was never loaded
+UPSSaveGameData* UPSGameInstanceSubsystem::FindSaveGame(const FString& SlotName) const
+{
+	const TObjectPtr<UPSSaveGameData>* FoundSaveGame = SaveGamesInternal.Find(SlotName);
+	return FoundSaveGame ? FoundSaveGame->Get() : nullptr;
+}
+
+// Keeps the loaded or created save profile of the slot for the whole game instance, null removes it
+void UPSGameInstanceSubsystem::SetSaveGame(const FString& SlotName, UPSSaveGameData* SaveGameData)
+{
+	if (SaveGameData)
+	{
+		SaveGamesInternal.Add(SlotName, SaveGameData);
+	}
+	else
+	{
+		SaveGamesInternal.Remove(SlotName);
+	}
+}
+
+// Keeps the loaded save as the profile of the slot, creates a new one with all rows of settings if it failed to load
+UPSSaveGameData* UPSGameInstanceSubsystem::AcquireSaveGame(const FString& SlotName, USaveGame* LoadedSaveGame, IPSProgressionOwner& ProgressionOwner, int32 LocalPlayerIndex)
+{
+	UPSSaveGameData* SaveGameData = Cast<UPSSaveGameData>(LoadedSaveGame);
+	if (!SaveGameData)
+	{
+		//  there is no save game file, or it is corrupted, create a new one
+		SaveGameData = Cast<UPSSaveGameData>(UGameplayStatics::CreateSaveGameObject(UPSSaveGameData::StaticClass()));
+		if (!ensureMsgf(SaveGameData, TEXT("ASSERT: [%i] %hs:\n'SaveGameData' can't be created!"), __LINE__, __FUNCTION__))
+		{
+			return nullptr;
+		}
+		ResetProgressionRows(*SaveGameData);
+	}
+
+	// The profile might be loaded by the previous world, so the owner is set again
+	SaveGameData->SetProgressionOwner(&ProgressionOwner, LocalPlayerIndex);
+	SetSaveGame(SlotName, SaveGameData);
+	return SaveGameData;
+}
+
+// Deletes the save file of the slot and replaces its profile by the new one with all rows of settings locked
+UPSSaveGameData* UPSGameInstanceSubsystem::ResetSaveGame(const FString& SlotName, IPSProgressionOwner& ProgressionOwner, int32 LocalPlayerIndex)
+{
+	UPSSaveGameData* SaveGameData = Cast<UPSSaveGameData>(UGameplayUtilsLibrary::ResetSaveGameData(FindSaveGame(SlotName), SlotName, LocalPlayerIndex));
+	checkf(SaveGameData, TEXT("ERROR: [%i] %hs:\n'SaveGameData' is null!"), __LINE__, __FUNCTION__);
+	ResetProgressionRows(*SaveGameData);
+	SaveGameData->SetProgressionOwner(&ProgressionOwner, LocalPlayerIndex);
+	SetSaveGame(SlotName, SaveGameData);
+	return SaveGameData;
+}
+
+// Writes the profile of the slot to disk on a worker thread, does nothing if the slot has no profile
+void UPSGameInstanceSubsystem::SaveGameAsync(const FString& SlotName, int32 LocalPlayerIndex) const
+{
+	if (UPSSaveGameData* SaveGameData = FindSaveGame(SlotName))
+	{
+		UGameplayStatics::AsyncSaveGameToSlot(SaveGameData, SlotName, LocalPlayerIndex);
+	}
+}
+
+// Adds all rows of settings to the profile as locked levels without progress
+void UPSGameInstanceSubsystem::ResetProgressionRows(UPSSaveGameData& SaveGameData) const
+{
+	for (const TTuple<FName, FPSRowData>& Row : ProgressionSettingsDataInternal)
+	{
+		SaveGameData.SetProgressionMap(Row.Key, FPSSaveToDiskData::EmptyData);
+	}
+}
+
+// Clears all state owned by this subsystem
+void UPSGameInstanceSubsystem::Deinitialize()
+{
+	for (const TTuple<FString, TObjectPtr<UPSSaveGameData>>& It : SaveGamesInternal)
+	{
+		if (It.Value)
+		{
+			It.Value->ConditionalBeginDestroy();
+		}
+	}
+	SaveGamesInternal.Empty();
+	ProgressionSettingsDataInternal.Empty();
+
+	Super::Deinitialize();
+}
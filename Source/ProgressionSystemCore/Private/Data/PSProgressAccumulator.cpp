@@ -0,0 +1,40 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSProgressAccumulator.h"
+
+// Adds points to the local player, is safe to call from any thread
+void FPSProgressAccumulator::Post(int32 LocalPlayerIndex, float Points)
+{
+	const int64 FixedPoints = FMath::RoundToInt64(static_cast<double>(Points) * FixedPointScale);
+	if (FixedPoints == 0
+		|| !ensureMsgf(LocalPlayerIndex >= 0 && LocalPlayerIndex < MaxLocalPlayers, TEXT("ASSERT: [%i] %hs:\n'LocalPlayerIndex' %i is out of range!"), __LINE__, __FUNCTION__, LocalPlayerIndex))
+	{
+		return;
+	}
+
+	// Only the sum matters, so no ordering with other memory is required
+	PlayerSlots[LocalPlayerIndex].FixedPoints.fetch_add(FixedPoints, std::memory_order_relaxed);
+	bHasPendingPoints.store(true, std::memory_order_release);
+}
+
+// Takes all points posted to the local player since the last call, is called on the game thread
+float FPSProgressAccumulator::Consume(int32 LocalPlayerIndex)
+{
+	if (LocalPlayerIndex < 0 || LocalPlayerIndex >= MaxLocalPlayers)
+	{
+		return 0.f;
+	}
+
+	const int64 FixedPoints = PlayerSlots[LocalPlayerIndex].FixedPoints.exchange(0, std::memory_order_acq_rel);
+	return static_cast<float>(static_cast<double>(FixedPoints) / FixedPointScale);
+}
+
+// Discards all posted points, e.g. when a new match is started
+void FPSProgressAccumulator::Reset()
+{
+	bHasPendingPoints.store(false, std::memory_order_relaxed);
+	for (FPlayerSlot& PlayerSlot : PlayerSlots)
+	{
+		PlayerSlot.FixedPoints.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,133 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSReplicationSubsystem.h"
+//---
+#include "Components/PSReplicationComponent.h"
+#include "Data/PSGameInstanceSubsystem.h"
+#include "Data/PSProgressionOwner.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Subsystems/GameDifficultySubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PSReplicationSubsystem)
+
+// Returns the subsystem of given object's world, is null if the world has no subsystems
+UPSReplicationSubsystem* UPSReplicationSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<ThisClass>() : nullptr;
+}
+
+// Returns the subsystem of given object's world, is checked
+UPSReplicationSubsystem& UPSReplicationSubsystem::GetChecked(const UObject& WorldContextObject)
+{
+	UPSReplicationSubsystem* ReplicationSubsystem = Get(&WorldContextObject);
+	checkf(ReplicationSubsystem, TEXT("ERROR: [%i] %hs:\n'ReplicationSubsystem' is null!"), __LINE__, __FUNCTION__);
+	return *ReplicationSubsystem;
+}
+
+// Sets the world object that applies replicated rows to local saves
+void UPSReplicationSubsystem::SetProgressionOwner(IPSProgressionOwner* NewProgressionOwner)
+{
+	ProgressionOwnerInternal = NewProgressionOwner;
+}
+
+// Returns settings of all progression rows, are copied from the data table once per game instance
+const TMap<FName, FPSRowData>& UPSReplicationSubsystem::GetProgressionSettings() const
+{
+	UPSGameInstanceSubsystem* GameInstanceSubsystem = UPSGameInstanceSubsystem::Get(this);
+	if (!GameInstanceSubsystem)
+	{
+		static const TMap<FName, FPSRowData> EmptySettings;
+		return EmptySettings;
+	}
+
+	// The presentation copies them once its data asset is loaded, dedicated servers load the configured table
+	const TMap<FName, FPSRowData>& ProgressionSettings = GameInstanceSubsystem->GetProgressionSettings();
+	return !ProgressionSettings.IsEmpty() ? ProgressionSettings : GameInstanceSubsystem->GetOrLoadProgressionSettings(ProgressionDataTableInternal.LoadSynchronous());
+}
+
+// Returns the multiplier of end-game rewards, is taken from the progression owner, or from the config if there is no owner
+float UPSReplicationSubsystem::GetRewardMultiplier() const
+{
+	if (const IPSProgressionOwner* ProgressionOwner = GetProgressionOwner())
+	{
+		return ProgressionOwner->GetProgressionRewardMultiplier();
+	}
+
+	const float* FoundMultiplier = ProgressionDifficultyMultiplierInternal.Find(UGameDifficultySubsystem::Get().GetDifficultyType());
+	if (!FoundMultiplier)
+	{
+		// No difficulty found, try to apply Any scenario
+		FoundMultiplier = ProgressionDifficultyMultiplierInternal.Find(EGameDifficulty::Any);
+	}
+	return FoundMultiplier ? *FoundMultiplier : 1.f;
+}
+
+// Adds points earned by an in-match event of the player, is called by the server that runs the match
+void UPSReplicationSubsystem::AddMatchProgress(APlayerState* PlayerState, float Points)
+{
+	if (UPSReplicationComponent* ReplicationComponent = PlayerState ? PlayerState->FindComponentByClass<UPSReplicationComponent>() : nullptr)
+	{
+		ReplicationComponent->AddMatchProgress(Points);
+	}
+}
+
+// Adds the replication component to the player state if it has none, is done by the server for each player in network games
+void UPSReplicationSubsystem::AddReplicationComponent(APlayerState* PlayerState)
+{
+	if (!PlayerState
+		|| !PlayerState->HasAuthority()
+		|| PlayerState->FindComponentByClass<UPSReplicationComponent>())
+	{
+		return;
+	}
+
+	// Is replicated by default, so clients receive it as a subobject of their player state
+	UPSReplicationComponent* ReplicationComponent = NewObject<UPSReplicationComponent>(PlayerState);
+	ReplicationComponent->RegisterComponent();
+}
+
+// Adds the replication component to all player states on the server of network games
+void UPSReplicationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// In network games the server owns the progression of each player, so each player state gets the replication component
+	const ENetMode NetMode = InWorld.GetNetMode();
+	if (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer)
+	{
+		if (const AGameStateBase* GameState = InWorld.GetGameState())
+		{
+			for (APlayerState* PlayerState : GameState->PlayerArray)
+			{
+				AddReplicationComponent(PlayerState);
+			}
+		}
+		ActorSpawnedHandleInternal = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::OnActorSpawned));
+	}
+}
+
+// Clears all transient data created by this subsystem
+void UPSReplicationSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandleInternal);
+	}
+	ActorSpawnedHandleInternal.Reset();
+	ProgressionOwnerInternal.Reset();
+
+	Super::Deinitialize();
+}
+
+// Adds the replication component to each spawned player state, is called on the server of network games
+void UPSReplicationSubsystem::OnActorSpawned(AActor* SpawnedActor)
+{
+	if (APlayerState* PlayerState = Cast<APlayerState>(SpawnedActor))
+	{
+		AddReplicationComponent(PlayerState);
+	}
+}
@@ -0,0 +1,192 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSSaveGameData.h"
+
+#include "Data/PSEventBus.h"
+#include "Data/PSProgressionOwner.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PSSaveGameData)
+
+// Retrieves the name of the save slot, safely initializing the name statically to ensure thread safety and initialization order.
+const FString& UPSSaveGameData::GetSaveSlotName()
+{
+	// Using a function-static variable to avoid the static initialization order fiasco
+	static const FString SaveSlotName = StaticClass()->GetName();
+	return SaveSlotName;
+}
+
+// Sets the owner of the progression in the world this save belongs to, so progression changes are applied to that world only
+void UPSSaveGameData::SetProgressionOwner(IPSProgressionOwner* InProgressionOwner, int32 InLocalPlayerIndex/* = 0*/)
+{
+	ProgressionOwnerInternal = InProgressionOwner;
+	LocalPlayerIndexInternal = InLocalPlayerIndex;
+}
+
+// Returns the owner of the progression in the world this save belongs to, is null if the owner is not set or its world is destroyed
+IPSProgressionOwner* UPSSaveGameData::GetProgressionOwner() const
+{
+	return ProgressionOwnerInternal.Get();
+}
+
+// Retrieves the saved game progression row by index from internal saved rows. If the index is out of range, returns a static empty data object. 
+FName UPSSaveGameData::GetSavedProgressionRowByIndex(int32 Index) const
+{
+	int32 Idx = 0;
+	for (const TTuple<FName, FPSSaveToDiskData>& It : ProgressionSettingsRowDataInternal)
+	{
+		if (Idx == Index)
+		{
+			return It.Key;
+		}
+	}
+	return FName();
+}
+
+// Sets the progression map with a new set of progression rows. Ensures the new map is not empty before assignment.
+void UPSSaveGameData::SetProgressionMap(FName RowName, const FPSSaveToDiskData& ProgressionRows)
+{
+	ProgressionSettingsRowDataInternal.Add(RowName, ProgressionRows);
+}
+
+// Unlocks the level specified by RowName if it exists in the saved progression rows.
+bool UPSSaveGameData::UnlockLevelByName(FName RowName)
+{
+	// Using the operator [] on a TMap like SavedProgressionRowsInternal[RowName] can inadvertently create a new entry in the map if RowName does not exist
+	// Check if the row exists to avoid inadvertently creating a new entry
+	if (ProgressionSettingsRowDataInternal.Contains(RowName))
+	{
+		FPSSaveToDiskData& CurrentRowRef = ProgressionSettingsRowDataInternal[RowName];
+		if (CurrentRowRef.IsLevelLocked)
+		{
+			CurrentRowRef.IsLevelLocked = false;
+			if (IPSProgressionOwner* ProgressionOwner = GetProgressionOwner())
+			{
+				ProgressionOwner->GetProgressionEventBus().LevelUnlocked.Broadcast(FPSLevelUnlockedEvent{RowName, LocalPlayerIndexInternal});
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+// Updates the current level's progression based on the end game state and proceeds to the next level if unlocked, the caller saves it to disk
+void UPSSaveGameData::AddEndGamePoints(EEndGameState EndGameState, float MatchProgress/* = 0.f*/)
+{
+	IPSProgressionOwner* ProgressionOwner = GetProgressionOwner();
+	if (!ensureMsgf(ProgressionOwner, TEXT("ASSERT: [%i] %hs:\n'ProgressionOwner' is null!"), __LINE__, __FUNCTION__))
+	{
+		return;
+	}
+	const FName CurrentRowName = ProgressionOwner->GetProgressionRowName(LocalPlayerIndexInternal);
+
+	// Check if the current row exists in the map before attempting to update it
+	if (FPSSaveToDiskData* CurrentSaveToDiskDataRowRef = ProgressionSettingsRowDataInternal.Find(CurrentRowName))
+	{
+		// Increase the current level's progression by the reward from the end game state
+		const float PreviousProgression = CurrentSaveToDiskDataRowRef->CurrentLevelProgression;
+		CurrentSaveToDiskDataRowRef->CurrentLevelProgression += GetProgressionReward(EndGameState) + MatchProgress;
+		ProgressionOwner->GetProgressionEventBus().ProgressChanged.Broadcast(FPSProgressChangedEvent{CurrentRowName, PreviousProgression, CurrentSaveToDiskDataRowRef->CurrentLevelProgression, LocalPlayerIndexInternal});
+
+		const FPSRowData& CurrentProgressionSettingsRowData = ProgressionOwner->GetProgressionRowSettings(LocalPlayerIndexInternal);
+
+		// Check if the current level progression has reached or surpassed the points needed to unlock
+		if (ShouldUnlockNextLevel(CurrentProgressionSettingsRowData, CurrentSaveToDiskDataRowRef->CurrentLevelProgression))
+		{
+			NextLevelProgressionRowData(); // Advance to the next level's progression data
+		}
+	}
+}
+
+// Is kept for existing callers: adds the end game reward as AddEndGamePoints does, but the profile is not saved to disk anymore
+void UPSSaveGameData::SavePoints(EEndGameState EndGameState)
+{
+	AddEndGamePoints(EndGameState);
+}
+
+// Advances to the next level progression row and unlocks it, if available, after the current row.
+void UPSSaveGameData::NextLevelProgressionRowData()
+{
+	const IPSProgressionOwner* ProgressionOwner = GetProgressionOwner();
+	if (!ensureMsgf(ProgressionOwner, TEXT("ASSERT: [%i] %hs:\n'ProgressionOwner' is null!"), __LINE__, __FUNCTION__))
+	{
+		return;
+	}
+
+	bool bNextRowFound = false;
+	const FName CurrentRowName = ProgressionOwner->GetProgressionRowName(LocalPlayerIndexInternal);
+
+	for (const TTuple<FName, FPSSaveToDiskData>& KeyValue : ProgressionSettingsRowDataInternal)
+	{
+		if (bNextRowFound)
+		{
+			UnlockLevelByName(KeyValue.Key);
+			break;
+		}
+
+		if (KeyValue.Key == CurrentRowName)
+		{
+			bNextRowFound = true; // Indicate that the current row has been found
+		}
+	}
+}
+
+// Unlocks all levels and set maximum allowed progression points
+void UPSSaveGameData::UnlockAllLevels()
+{
+	IPSProgressionOwner* ProgressionOwner = GetProgressionOwner();
+	if (!ensureMsgf(ProgressionOwner, TEXT("ASSERT: [%i] %hs:\n'ProgressionOwner' is null!"), __LINE__, __FUNCTION__))
+	{
+		return;
+	}
+	const float PointsToUnlock = ProgressionOwner->GetProgressionRowSettings(LocalPlayerIndexInternal).PointsToUnlock;
+
+	for (TTuple<FName, FPSSaveToDiskData>& KeyValue : ProgressionSettingsRowDataInternal)
+	{
+		UnlockLevelByName(KeyValue.Key);
+
+		const float PreviousProgression = KeyValue.Value.CurrentLevelProgression;
+		KeyValue.Value.CurrentLevelProgression = PointsToUnlock;
+		if (PreviousProgression != KeyValue.Value.CurrentLevelProgression)
+		{
+			ProgressionOwner->GetProgressionEventBus().ProgressChanged.Broadcast(FPSProgressChangedEvent{KeyValue.Key, PreviousProgression, KeyValue.Value.CurrentLevelProgression, LocalPlayerIndexInternal});
+		}
+	}
+}
+
+// @h4rdmol - make function const
+// Retrieves the progression reward based on the end game state for the current level.
+float UPSSaveGameData::GetProgressionReward(EEndGameState EndGameState)
+{
+	const IPSProgressionOwner* ProgressionOwner = GetProgressionOwner();
+	if (!ensureMsgf(ProgressionOwner, TEXT("ASSERT: [%i] %hs:\n'ProgressionOwner' is null!"), __LINE__, __FUNCTION__))
+	{
+		return 0.f;
+	}
+	return CalculateProgressionReward(ProgressionOwner->GetProgressionRowSettings(LocalPlayerIndexInternal), EndGameState, ProgressionOwner->GetProgressionRewardMultiplier());
+}
+
+// Returns the endgame reward of the level, is the single formula for local saves and the server
+float UPSSaveGameData::CalculateProgressionReward(const FPSRowData& RowSettings, EEndGameState EndGameState, float RewardMultiplier)
+{
+	constexpr float DefaultMultiplier = 1.0f;
+	const float* LevelReward = RowSettings.ProgressionEndGameValues.Find(EndGameState);
+	const float ProgressionReward = LevelReward ? *LevelReward : DefaultMultiplier;
+	return ProgressionReward * RewardMultiplier;
+}
+
+// Returns true if enough points are achieved on the level to unlock the next one
+bool UPSSaveGameData::ShouldUnlockNextLevel(const FPSRowData& RowSettings, float LevelProgression)
+{
+	return LevelProgression >= RowSettings.PointsToUnlock;
+}
+
+// Returns the current save to disk data by name
+const FPSSaveToDiskData& UPSSaveGameData::GetSaveToDiskDataByName(FName CurrentRowName) const
+{
+	if (const FPSSaveToDiskData* FoundSeeting = ProgressionSettingsRowDataInternal.Find(CurrentRowName))
+	{
+		return *FoundSeeting;
+	}
+
+	return  FPSSaveToDiskData::EmptyData;
+}
@@ -0,0 +1,97 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSSnapshot.h"
+//---
+#include "HAL/PlatformProcess.h"
+
+const FPSPlayerSnapshot FPSProgressionSnapshot::EmptyPlayer = FPSPlayerSnapshot{};
+
+// Returns the progression of the local player, is empty if the player is not tracked
+const FPSPlayerSnapshot& FPSProgressionSnapshot::GetPlayer(int32 LocalPlayerIndex) const
+{
+	return Players.IsValidIndex(LocalPlayerIndex) ? Players[LocalPlayerIndex] : EmptyPlayer;
+}
+
+// Returns the saved data of the row of the local player, is empty if the row is not found
+const FPSSaveToDiskData& FPSProgressionSnapshot::GetRow(FName RowName, int32 LocalPlayerIndex) const
+{
+	const FPSSnapshotRowsPtr& Rows = GetPlayer(LocalPlayerIndex).Rows;
+	const FPSSaveToDiskData* FoundRow = Rows.IsValid() ? Rows->Find(RowName) : nullptr;
+	return FoundRow ? *FoundRow : FPSSaveToDiskData::EmptyData;
+}
+
+// Returns the saved data of the current row of the local player
+const FPSSaveToDiskData& FPSProgressionSnapshot::GetCurrentRow(int32 LocalPlayerIndex) const
+{
+	return GetRow(GetPlayer(LocalPlayerIndex).CurrentRowName, LocalPlayerIndex);
+}
+
+// Returns the points required to unlock the level, 0 if the row is not found
+float FPSProgressionSnapshot::GetPointsToUnlock(FName RowName) const
+{
+	const float* FoundPoints = PointsToUnlock.IsValid() ? PointsToUnlock->Find(RowName) : nullptr;
+	return FoundPoints ? *FoundPoints : 0.f;
+}
+
+// Returns the last published snapshot, is safe to call from any thread
+FPSProgressionSnapshotPtr FPSSnapshotPublisher::Get() const
+{
+	while (true)
+	{
+		// The reader is counted before the slot is checked to be still published, so the writer does not overwrite it while the pointer is copied
+		const int32 SlotIndex = PublishedSlotIndex.load();
+		const FSlot& Slot = Slots[SlotIndex];
+		Slot.ReadersNum.fetch_add(1);
+		if (PublishedSlotIndex.load() == SlotIndex)
+		{
+			FPSProgressionSnapshotPtr Snapshot = Slot.Snapshot;
+			Slot.ReadersNum.fetch_sub(1);
+			return Snapshot;
+		}
+
+		// A newer snapshot was published meanwhile, it's taken instead
+		Slot.ReadersNum.fetch_sub(1);
+	}
+}
+
+// Replaces the published snapshot, is called by one writer thread only
+void FPSSnapshotPublisher::Publish(const FPSProgressionSnapshotPtr& NewSnapshot)
+{
+	const int32 PreviousSlotIndex = PublishedSlotIndex.load();
+
+	// Find the slot that is neither published nor read, readers hold it only to copy the pointer, so it's free almost always
+	int32 FreeSlotIndex = INDEX_NONE;
+	while (FreeSlotIndex == INDEX_NONE)
+	{
+		for (int32 SlotIndex = 0; SlotIndex < SlotsNum; ++SlotIndex)
+		{
+			if (SlotIndex != PreviousSlotIndex
+				&& Slots[SlotIndex].ReadersNum.load() == 0)
+			{
+				FreeSlotIndex = SlotIndex;
+				break;
+			}
+		}
+
+		if (FreeSlotIndex == INDEX_NONE)
+		{
+			FPlatformProcess::YieldThread();
+		}
+	}
+
+	Slots[FreeSlotIndex].Snapshot = NewSnapshot;
+	PublishedSlotIndex.store(FreeSlotIndex);
+
+	// Readers that start after the swap take the new slot, readers of replaced slots see they are not published anymore and retry without copying,
+	// so all replaced snapshots that are not being copied right now are released
+	for (int32 SlotIndex = 0; SlotIndex < SlotsNum; ++SlotIndex)
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		if (SlotIndex != FreeSlotIndex
+			&& Slot.Snapshot.IsValid()
+			&& Slot.ReadersNum.load() == 0)
+		{
+			Slot.Snapshot.Reset();
+		}
+	}
+}
@@ -0,0 +1,497 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Components/PSReplicationComponent.h"
+//---
+#include "Data/PSReplicationSubsystem.h"
+#include "Data/PSSaveGameData.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/CoreNet.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#endif
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PSReplicationTests
+{
+	/** Points to unlock each level in the test */
+	constexpr float PointsToUnlock = 3.f;
+
+	/** Serializes rows as plain structs, so the fast array is delta serialized without the net driver */
+	class FNetSerializeCB final : public INetSerializeCB
+	{
+	public:
+		virtual void NetSerializeStruct(FNetDeltaSerializeInfo& Params) override
+		{
+			FBitArchive& Ar = Params.Reader ? static_cast<FBitArchive&>(*Params.Reader) : static_cast<FBitArchive&>(*Params.Writer);
+			CastChecked<UScriptStruct>(Params.Struct)->SerializeBin(Ar, Params.Data);
+		}
+
+		virtual void GatherGuidReferencesForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool MoveGuidToUnmappedForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+		virtual void UpdateUnmappedGuidsForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool NetDeltaSerializeForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+	};
+
+	/** Returns settings of the given amount of levels, each level requires the same points to unlock */
+	TMap<FName, FPSRowData> MakeSettings(int32 RowsNum)
+	{
+		TMap<FName, FPSRowData> Settings;
+		for (int32 Index = 0; Index < RowsNum; ++Index)
+		{
+			FPSRowData& RowSettings = Settings.Add(*FString::Printf(TEXT("Level%i"), Index));
+			RowSettings.PointsToUnlock = PointsToUnlock;
+		}
+		return Settings;
+	}
+
+	/** Creates rows in the same state as the server after seeding the empty upload: the first level is unlocked, others are locked */
+	void MakeSeededRows(FPSReplicatedRows& OutRows, const TMap<FName, FPSRowData>& Settings)
+	{
+		OutRows.SeedRows(Settings, {});
+		for (FPSReplicatedRow& Row : OutRows.Items)
+		{
+			OutRows.MarkItemDirty(Row);
+		}
+	}
+
+	/** Writes rows changed since the base state the same way as the actor channel does, the base state is replaced by the new one.
+	 * @return false if nothing is changed, so nothing has to be sent. */
+	bool WriteDelta(FPSReplicatedRows& Rows, TSharedPtr<INetDeltaBaseState>& InOutBaseState, FNetBitWriter& OutWriter)
+	{
+		FNetSerializeCB NetSerializeCB;
+		TSharedPtr<INetDeltaBaseState> NewState;
+		FNetDeltaSerializeInfo DeltaParms;
+		DeltaParms.Writer = &OutWriter;
+		DeltaParms.OldState = InOutBaseState.Get();
+		DeltaParms.NewState = &NewState;
+		DeltaParms.NetSerializeCB = &NetSerializeCB;
+
+		const bool bIsWritten = Rows.NetDeltaSerialize(DeltaParms);
+		if (bIsWritten)
+		{
+			InOutBaseState = NewState;
+		}
+		return bIsWritten;
+	}
+
+	/** Reads the written delta to the client rows, replication callbacks of rows are called as on clients. */
+	bool ReadDelta(FPSReplicatedRows& ClientRows, FNetBitWriter& Writer)
+	{
+		FNetSerializeCB NetSerializeCB;
+		FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+		FNetDeltaSerializeInfo DeltaParms;
+		DeltaParms.Reader = &Reader;
+		DeltaParms.NetSerializeCB = &NetSerializeCB;
+
+		return ClientRows.NetDeltaSerialize(DeltaParms) && !Reader.IsError();
+	}
+
+	/** Returns true if the client received the same rows as the server has */
+	bool AreRowsEqual(const FPSReplicatedRows& ServerRows, const FPSReplicatedRows& ClientRows)
+	{
+		if (ServerRows.Items.Num() != ClientRows.Items.Num())
+		{
+			return false;
+		}
+
+		for (const FPSReplicatedRow& ServerRow : ServerRows.Items)
+		{
+			const int32 ClientRowIndex = ClientRows.IndexOfRow(ServerRow.RowName);
+			if (!ClientRows.Items.IsValidIndex(ClientRowIndex)
+				|| ClientRows.Items[ClientRowIndex].SaveToDiskData.CurrentLevelProgression != ServerRow.SaveToDiskData.CurrentLevelProgression
+				|| ClientRows.Items[ClientRowIndex].SaveToDiskData.IsLevelLocked != ServerRow.SaveToDiskData.IsLevelLocked)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Applies the match result the same way as the server and returns the amount of rows marked dirty by it */
+	int32 ApplyMatchResult(FPSReplicatedRows& Rows, const TMap<FName, FPSRowData>& Settings, int32 RowIndex, float Reward)
+	{
+		TArray<int32, TInlineAllocator<2>> ChangedRowIndices;
+		Rows.AddReward(RowIndex, Settings.FindChecked(Rows.Items[RowIndex].RowName), Reward, ChangedRowIndices);
+		for (const int32 ChangedRowIndex : ChangedRowIndices)
+		{
+			Rows.MarkItemDirty(Rows.Items[ChangedRowIndex]);
+		}
+		return ChangedRowIndices.Num();
+	}
+
+	/** Returns the saved progression of one level */
+	FPSSaveToDiskData MakeSaveToDiskData(float LevelProgression, bool bIsLevelLocked)
+	{
+		FPSSaveToDiskData SaveToDiskData;
+		SaveToDiskData.CurrentLevelProgression = LevelProgression;
+		SaveToDiskData.IsLevelLocked = bIsLevelLocked;
+		return SaveToDiskData;
+	}
+
+	/** Returns the uploaded row with the given progress and lock state */
+	FPSReplicatedRow MakeSavedRow(int32 RowIndex, float LevelProgression, bool bIsLevelLocked)
+	{
+		return FPSReplicatedRow(*FString::Printf(TEXT("Level%i"), RowIndex), MakeSaveToDiskData(LevelProgression, bIsLevelLocked));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSReplicationNetDeltaSerializeTest, "ProgressionSystem.Replication.NetDeltaSerialize",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+// Checks that the delta serialization sends the full base state once, then only changed rows, and the client receives the same rows
+bool FPSReplicationNetDeltaSerializeTest::RunTest(const FString& Parameters)
+{
+	using namespace PSReplicationTests;
+
+	const TMap<FName, FPSRowData> Settings = MakeSettings(16);
+	FPSReplicatedRows ServerRows;
+	MakeSeededRows(ServerRows, Settings);
+	FPSReplicatedRows ClientRows;
+	TSharedPtr<INetDeltaBaseState> BaseState;
+
+	// The first bunch has no base state, so all rows are sent
+	FNetBitWriter BaseWriter(nullptr, 0);
+	TestTrue(TEXT("Base state is written"), WriteDelta(ServerRows, BaseState, BaseWriter));
+	TestTrue(TEXT("Base state is read"), ReadDelta(ClientRows, BaseWriter));
+	TestTrue(TEXT("Client received all rows of the base state"), AreRowsEqual(ServerRows, ClientRows));
+
+	// Nothing is sent while rows are not changed
+	FNetBitWriter UnchangedWriter(nullptr, 0);
+	TestFalse(TEXT("Unchanged rows are not written"), WriteDelta(ServerRows, BaseState, UnchangedWriter));
+
+	// The match result sends only the played row
+	ApplyMatchResult(ServerRows, Settings, 0, 1.f);
+	FNetBitWriter DeltaWriter(nullptr, 0);
+	TestTrue(TEXT("Delta is written"), WriteDelta(ServerRows, BaseState, DeltaWriter));
+	TestTrue(TEXT("Delta is smaller than the base state"), DeltaWriter.GetNumBits() < BaseWriter.GetNumBits());
+	TestTrue(TEXT("Delta is read"), ReadDelta(ClientRows, DeltaWriter));
+	TestTrue(TEXT("Client received the changed row"), AreRowsEqual(ServerRows, ClientRows));
+
+	// The unlock sends the played row and the unlocked one
+	ApplyMatchResult(ServerRows, Settings, 0, PointsToUnlock);
+	FNetBitWriter UnlockWriter(nullptr, 0);
+	TestTrue(TEXT("Unlock delta is written"), WriteDelta(ServerRows, BaseState, UnlockWriter));
+	TestTrue(TEXT("Unlock delta is read"), ReadDelta(ClientRows, UnlockWriter));
+	TestTrue(TEXT("Client received the unlocked row"), AreRowsEqual(ServerRows, ClientRows));
+	TestFalse(TEXT("Next level is unlocked on the client"), ClientRows.Items[1].SaveToDiskData.IsLevelLocked);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSReplicationBytesPerMatchResultTest, "ProgressionSystem.Replication.BytesPerMatchResult",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+// Checks that one match result replicates only the played row and the unlocked one, whatever the amount of levels is
+bool FPSReplicationBytesPerMatchResultTest::RunTest(const FString& Parameters)
+{
+	using namespace PSReplicationTests;
+
+	const TMap<FName, FPSRowData> FewSettings = MakeSettings(4);
+	FPSReplicatedRows FewRows;
+	MakeSeededRows(FewRows, FewSettings);
+	TSharedPtr<INetDeltaBaseState> FewBaseState;
+	FNetBitWriter FewBaseWriter(nullptr, 0);
+	WriteDelta(FewRows, FewBaseState, FewBaseWriter);
+
+	const TMap<FName, FPSRowData> ManySettings = MakeSettings(64);
+	FPSReplicatedRows ManyRows;
+	MakeSeededRows(ManyRows, ManySettings);
+	TSharedPtr<INetDeltaBaseState> ManyBaseState;
+	FNetBitWriter ManyBaseWriter(nullptr, 0);
+	WriteDelta(ManyRows, ManyBaseState, ManyBaseWriter);
+
+	// The match without unlock changes only the played row
+	TestEqual(TEXT("Rows dirtied by the match without unlock"), ApplyMatchResult(FewRows, FewSettings, 0, 1.f), 1);
+	FNetBitWriter FewDeltaWriter(nullptr, 0);
+	WriteDelta(FewRows, FewBaseState, FewDeltaWriter);
+	TestEqual(TEXT("Rows dirtied by the match without unlock of many levels"), ApplyMatchResult(ManyRows, ManySettings, 0, 1.f), 1);
+	FNetBitWriter ManyDeltaWriter(nullptr, 0);
+	WriteDelta(ManyRows, ManyBaseState, ManyDeltaWriter);
+	TestEqual(TEXT("Bits per match result don't depend on the amount of levels"), ManyDeltaWriter.GetNumBits(), FewDeltaWriter.GetNumBits());
+
+	// The match that reaches the points to unlock changes the next row too
+	TestEqual(TEXT("Rows dirtied by the match with unlock"), ApplyMatchResult(ManyRows, ManySettings, 0, PointsToUnlock), 2);
+	FNetBitWriter UnlockWriter(nullptr, 0);
+	WriteDelta(ManyRows, ManyBaseState, UnlockWriter);
+	TestTrue(TEXT("Bits per match with unlock are more than one row"), UnlockWriter.GetNumBits() > ManyDeltaWriter.GetNumBits());
+	TestTrue(TEXT("Bits per match with unlock are less than all rows"), UnlockWriter.GetNumBits() < ManyBaseWriter.GetNumBits());
+
+	// The next match on the same level doesn't send the already unlocked row again
+	TestEqual(TEXT("Rows dirtied after the level is unlocked"), ApplyMatchResult(ManyRows, ManySettings, 0, 1.f), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSReplicationSeedRowsTest, "ProgressionSystem.Replication.SeedRows",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+// Checks that the server validates the uploaded progression by its own settings with the same unlock rule as local saves
+bool FPSReplicationSeedRowsTest::RunTest(const FString& Parameters)
+{
+	using namespace PSReplicationTests;
+
+	const TMap<FName, FPSRowData> Settings = MakeSettings(4);
+	FPSReplicatedRows Rows;
+
+	// The empty upload unlocks only the first level
+	Rows.SeedRows(Settings, {});
+	TestEqual(TEXT("Rows are created for all levels of settings"), Rows.Items.Num(), Settings.Num());
+	TestFalse(TEXT("The first level is always unlocked"), Rows.Items[0].SaveToDiskData.IsLevelLocked);
+	TestTrue(TEXT("Missing levels are locked"), Rows.Items[1].SaveToDiskData.IsLevelLocked);
+
+	// The valid progression is kept as is
+	Rows.SeedRows(Settings, {MakeSavedRow(0, PointsToUnlock, false), MakeSavedRow(1, 1.f, false)});
+	TestFalse(TEXT("Level unlocked by enough points stays unlocked"), Rows.Items[1].SaveToDiskData.IsLevelLocked);
+	TestEqual(TEXT("Progress of the unlocked level is kept"), Rows.Items[1].SaveToDiskData.CurrentLevelProgression, 1.f);
+
+	// Levels unlocked without enough points on the previous one are locked again and lose their progress
+	Rows.SeedRows(Settings, {MakeSavedRow(0, 1.f, false), MakeSavedRow(1, 2.f, false), MakeSavedRow(2, PointsToUnlock, false)});
+	TestTrue(TEXT("Level unlocked without enough points is locked"), Rows.Items[1].SaveToDiskData.IsLevelLocked);
+	TestEqual(TEXT("Progress of the locked level is reset"), Rows.Items[1].SaveToDiskData.CurrentLevelProgression, 0.f);
+	TestTrue(TEXT("Level after the locked one is locked"), Rows.Items[2].SaveToDiskData.IsLevelLocked);
+
+	// Invalid numbers are never accepted
+	Rows.SeedRows(Settings, {MakeSavedRow(0, -5.f, true), MakeSavedRow(1, NAN, false)});
+	TestFalse(TEXT("Locked first level is unlocked"), Rows.Items[0].SaveToDiskData.IsLevelLocked);
+	TestEqual(TEXT("Negative progress is reset"), Rows.Items[0].SaveToDiskData.CurrentLevelProgression, 0.f);
+	TestTrue(TEXT("Level after the level without points is locked"), Rows.Items[1].SaveToDiskData.IsLevelLocked);
+	TestEqual(TEXT("Not finite progress is reset"), Rows.Items[1].SaveToDiskData.CurrentLevelProgression, 0.f);
+
+	// Rows unknown to the server are skipped
+	Rows.SeedRows(Settings, {FPSReplicatedRow(TEXT("UnknownLevel"), FPSSaveToDiskData::EmptyData)});
+	TestEqual(TEXT("Unknown rows are not added"), Rows.IndexOfRow(TEXT("UnknownLevel")), static_cast<int32>(INDEX_NONE));
+
+	return true;
+}
+
+#if WITH_EDITOR
+
+/** Drives the server side of the upload and reward, so the network test doesn't wait for the whole match. */
+struct FPSReplicationTestAccess
+{
+	/** Allows the progression to be uploaded again, the component is seeded once the PIE player loads its save. */
+	static void ResetSeeded(UPSReplicationComponent& ReplicationComponent) { ReplicationComponent.bIsSeededInternal = false; }
+
+	/** Returns true if the server accepts the uploaded rows, the client is disconnected otherwise. */
+	static bool ValidateUpload(UPSReplicationComponent& ReplicationComponent, const TArray<FPSReplicatedRow>& SavedRows) { return ReplicationComponent.ServerUploadProgression_Validate(SavedRows); }
+
+	/** Adds the reward to the row as the end-game result does. */
+	static void AddRowReward(UPSReplicationComponent& ReplicationComponent, int32 RowIndex, const FPSRowData& RowSettings, float Reward) { ReplicationComponent.AddRowReward(RowIndex, RowSettings, Reward); }
+};
+
+namespace PSReplicationTests
+{
+	/** Maximum seconds to wait for the PIE session and each replicated change */
+	constexpr float NetworkTimeout = 30.f;
+
+	/** Components of the same client player on both sides of the connection */
+	struct FNetworkTestState
+	{
+		TWeakObjectPtr<UPSReplicationComponent> ServerComponent = nullptr;
+		TWeakObjectPtr<UPSReplicationComponent> ClientComponent = nullptr;
+		FPSReplicatedRows ExpectedRows;
+	};
+
+	/** Returns the PIE world of the given net mode, null if it's not started yet. */
+	UWorld* FindPIEWorld(ENetMode NetMode)
+	{
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			UWorld* World = WorldContext.World();
+			if (WorldContext.WorldType == EWorldType::PIE
+				&& World
+				&& World->GetNetMode() == NetMode)
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+
+	/** Finds the replication component of the client player on the client and on the listen server.
+	 * @return true once both components exist. */
+	bool FindComponents(FNetworkTestState& OutState)
+	{
+		const UWorld* ClientWorld = FindPIEWorld(NM_Client);
+		const UWorld* ServerWorld = FindPIEWorld(NM_ListenServer);
+		const APlayerController* ClientController = ClientWorld ? ClientWorld->GetFirstPlayerController() : nullptr;
+		const APlayerState* ClientPlayerState = ClientController ? ClientController->PlayerState : nullptr;
+		const AGameStateBase* ServerGameState = ServerWorld ? ServerWorld->GetGameState() : nullptr;
+		if (!ClientPlayerState || !ServerGameState)
+		{
+			return false;
+		}
+
+		OutState.ClientComponent = ClientPlayerState->FindComponentByClass<UPSReplicationComponent>();
+		for (const APlayerState* PlayerState : ServerGameState->PlayerArray)
+		{
+			if (PlayerState && PlayerState->GetPlayerId() == ClientPlayerState->GetPlayerId())
+			{
+				OutState.ServerComponent = PlayerState->FindComponentByClass<UPSReplicationComponent>();
+			}
+		}
+		return OutState.ServerComponent.IsValid() && OutState.ClientComponent.IsValid();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSReplicationNetworkTest, "ProgressionSystem.Replication.Network",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+// Checks the upload, reward and replicated rows between the listen server and the client of the PIE session
+bool FPSReplicationNetworkTest::RunTest(const FString& Parameters)
+{
+	using namespace PSReplicationTests;
+
+	if (!GEditor)
+	{
+		AddError(TEXT("The network test requires the editor to start the PIE session"));
+		return false;
+	}
+
+	// The listen server and the client run in the same process, so both worlds are available here
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_ListenServer);
+	PlaySettings->SetPlayNumberOfClients(2);
+	PlaySettings->SetRunUnderOneProcess(true);
+	PlaySettings->bLaunchSeparateServer = false;
+
+	FRequestPlaySessionParams PlaySessionParams;
+	PlaySessionParams.EditorPlaySettings = PlaySettings;
+	PlaySessionParams.WorldType = EPlaySessionWorldType::PlayInEditor;
+	GEditor->RequestPlaySession(PlaySessionParams);
+
+	const TSharedRef<FNetworkTestState> State = MakeShared<FNetworkTestState>();
+	const auto OnTimeout = [this](const TCHAR* Step)
+	{
+		return [this, Step]
+		{
+			AddError(FString::Printf(TEXT("Timeout: %s"), Step));
+			GEditor->RequestEndPlayMap();
+			return true;
+		};
+	};
+
+	// The server adds the replication component to the player state of the client
+	ADD_LATENT_AUTOMATION_COMMAND(FUntilCommand([State] { return FindComponents(*State); }, OnTimeout(TEXT("Replication components are not created")), NetworkTimeout));
+
+	// The client uploads the progression with invalid rows, the server validates it by its own settings
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]
+	{
+		UPSReplicationComponent* ServerComponent = State->ServerComponent.Get();
+		UPSReplicationComponent* ClientComponent = State->ClientComponent.Get();
+		if (!ServerComponent || !ClientComponent)
+		{
+			return true;
+		}
+
+		// Rows are checked on the components only, so the test doesn't write to local saves
+		UPSReplicationSubsystem::GetChecked(*ServerComponent).SetProgressionOwner(nullptr);
+		UPSReplicationSubsystem::GetChecked(*ClientComponent).SetProgressionOwner(nullptr);
+
+		const TMap<FName, FPSRowData>& Settings = UPSReplicationSubsystem::GetChecked(*ServerComponent).GetProgressionSettings();
+		TArray<FName> RowNames;
+		Settings.GetKeys(RowNames);
+		if (RowNames.Num() < 2)
+		{
+			AddInfo(TEXT("Skipped: the progression data table has less than 2 levels"));
+			State->ServerComponent.Reset();
+			return true;
+		}
+
+		// The server disconnects clients that upload more rows than it has
+		TArray<FPSReplicatedRow> TooManyRows;
+		TooManyRows.SetNum(Settings.Num() + 1);
+		TestFalse(TEXT("Upload with more rows than settings is rejected"), FPSReplicationTestAccess::ValidateUpload(*ServerComponent, TooManyRows));
+
+		// The first level has enough points, the second one has no valid number, the unknown one doesn't exist on the server
+		UPSSaveGameData* SaveGameData = NewObject<UPSSaveGameData>();
+		const FPSRowData& FirstRowSettings = Settings.FindChecked(RowNames[0]);
+		SaveGameData->SetProgressionMap(RowNames[0], MakeSaveToDiskData(FirstRowSettings.PointsToUnlock, false));
+		SaveGameData->SetProgressionMap(RowNames[1], MakeSaveToDiskData(NAN, false));
+		SaveGameData->SetProgressionMap(TEXT("UnknownLevel"), MakeSaveToDiskData(FirstRowSettings.PointsToUnlock, false));
+
+		TArray<FPSReplicatedRow> SavedRows;
+		for (const TTuple<FName, FPSSaveToDiskData>& It : SaveGameData->GetProgressionSettingsRowDataInternal())
+		{
+			SavedRows.Emplace(It.Key, It.Value);
+		}
+		TestTrue(TEXT("Upload with known amount of rows is accepted"), FPSReplicationTestAccess::ValidateUpload(*ServerComponent, SavedRows));
+		State->ExpectedRows.SeedRows(Settings, SavedRows);
+
+		// The component is already seeded by the save of the PIE player, so it's allowed to be uploaded again by the RPC
+		FPSReplicationTestAccess::ResetSeeded(*ServerComponent);
+		FPSReplicationTestAccess::ResetSeeded(*ClientComponent);
+		ClientComponent->UploadLocalProgression(SaveGameData);
+		return true;
+	}));
+
+	// The client receives rows validated by the server
+	ADD_LATENT_AUTOMATION_COMMAND(FUntilCommand([State]
+	{
+		const UPSReplicationComponent* ServerComponent = State->ServerComponent.Get();
+		const UPSReplicationComponent* ClientComponent = State->ClientComponent.Get();
+		return !ServerComponent || !ClientComponent
+			|| (ServerComponent->IsSeeded() && AreRowsEqual(State->ExpectedRows, ClientComponent->GetReplicatedRows()));
+	}, OnTimeout(TEXT("Uploaded rows are not replicated")), NetworkTimeout));
+
+	// Only the server accumulates in-match progress, then applies the reward that unlocks the next level
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]
+	{
+		UPSReplicationComponent* ServerComponent = State->ServerComponent.Get();
+		UPSReplicationComponent* ClientComponent = State->ClientComponent.Get();
+		if (!ServerComponent || !ClientComponent)
+		{
+			return true;
+		}
+
+		TestTrue(TEXT("Server rows are validated"), AreRowsEqual(State->ExpectedRows, ServerComponent->GetReplicatedRows()));
+		TestEqual(TEXT("Not finite progress is reset by the server"), ServerComponent->GetReplicatedRows().Items[1].SaveToDiskData.CurrentLevelProgression, 0.f);
+
+		const float MaxMatchProgress = UPSReplicationSubsystem::GetChecked(*ServerComponent).GetMaxMatchProgress();
+		ServerComponent->AddMatchProgress(MaxMatchProgress + 1.f);
+		TestEqual(TEXT("Match progress is clamped by the max"), ServerComponent->GetMatchProgress(), MaxMatchProgress);
+		ServerComponent->AddMatchProgress(-(MaxMatchProgress + 1.f));
+		TestEqual(TEXT("Match progress is not negative"), ServerComponent->GetMatchProgress(), 0.f);
+		ClientComponent->AddMatchProgress(1.f);
+		TestEqual(TEXT("Client can't add match progress"), ClientComponent->GetMatchProgress(), 0.f);
+
+		const FPSReplicatedRow& SecondRow = ServerComponent->GetReplicatedRows().Items[1];
+		const FPSRowData& SecondRowSettings = UPSReplicationSubsystem::GetChecked(*ServerComponent).GetProgressionSettings().FindChecked(SecondRow.RowName);
+		FPSReplicationTestAccess::AddRowReward(*ServerComponent, 1, SecondRowSettings, SecondRowSettings.PointsToUnlock);
+		TArray<int32, TInlineAllocator<2>> ChangedRowIndices;
+		State->ExpectedRows.AddReward(1, SecondRowSettings, SecondRowSettings.PointsToUnlock, ChangedRowIndices);
+		return true;
+	}));
+
+	// The client receives the rewarded row and the unlocked one
+	ADD_LATENT_AUTOMATION_COMMAND(FUntilCommand([State]
+	{
+		const UPSReplicationComponent* ClientComponent = State->ClientComponent.Get();
+		return !State->ServerComponent.IsValid() || !ClientComponent
+			|| AreRowsEqual(State->ExpectedRows, ClientComponent->GetReplicatedRows());
+	}, OnTimeout(TEXT("Rewarded rows are not replicated")), NetworkTimeout));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]
+	{
+		if (const UPSReplicationComponent* ClientComponent = State->ClientComponent.Get())
+		{
+			const TArray<FPSReplicatedRow>& ClientRows = ClientComponent->GetReplicatedRows().Items;
+			TestTrue(TEXT("Level after the rewarded one is unlocked on the client"), State->ExpectedRows.Items.Num() < 3 || !ClientRows[2].SaveToDiskData.IsLevelLocked);
+		}
+		GEditor->RequestEndPlayMap();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif // WITH_EDITOR
+
+#endif // WITH_DEV_AUTOMATION_TESTS
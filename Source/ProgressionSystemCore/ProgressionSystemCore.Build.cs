@@ -0,0 +1,37 @@
+﻿// Copyright (c) Valeriy Rotermel and Yevhenii Selivanov
+
+using UnrealBuildTool;
+
+public class ProgressionSystemCore : ModuleRules
+{
+	public ProgressionSystemCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		CppStandard = CppStandardVersion.Latest; 
+		bEnableNonInlinedGenCppWarnings = true;
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+		// Data, save, reward, unlock and replication logic only, UI modules must not be added here.
+		// Note: the Bomber game module still links UMG and SettingsWidgetConstructor itself,
+		// so this module is UI-free only in its own code until ELevelType, EEndGameState and FPlayerTag are moved to a UI-free game module
+		PublicDependencyModuleNames.AddRange(new[]
+			{
+				"Core", "CoreUObject", "Engine"
+				, "NetCore" // FFastArraySerializer of PSReplicationComponent
+				// Bomber modules
+				, "Bomber" // ELevelType, EEndGameState, FPlayerTag
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(new[]
+			{
+				// Bomber modules 
+				"MyUtils" // UMyDataTable
+			}
+		);
+
+		if (Target.bBuildEditor)
+		{
+			// The network test of PSReplicationTests starts the PIE session
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
+	}
+}
@@ -0,0 +1,195 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Data/PSCoreTypes.h"
+#include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "PSReplicationComponent.generated.h"
+
+/**
+ * The progression of one level replicated by the server.
+ * Only changed rows are sent by the fast array delta serialization.
+ */
+USTRUCT(BlueprintType)
+struct PROGRESSIONSYSTEMCORE_API FPSReplicatedRow : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Default constructor. */
+	FPSReplicatedRow() = default;
+
+	/** Constructor with the row and its progression. */
+	FPSReplicatedRow(FName InRowName, const FPSSaveToDiskData& InSaveToDiskData)
+		: RowName(InRowName), SaveToDiskData(InSaveToDiskData) {}
+
+	/** The progression row of the data table */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "C++")
+	FName RowName = NAME_None;
+
+	/** Achieved points and the lock state of the level */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "C++")
+	FPSSaveToDiskData SaveToDiskData;
+
+	/** Is called on clients when the row is received for the first time. */
+	void PostReplicatedAdd(const struct FPSReplicatedRows& InArraySerializer);
+
+	/** Is called on clients when the row is changed by the server. */
+	void PostReplicatedChange(const struct FPSReplicatedRows& InArraySerializer);
+};
+
+/**
+ * All progression rows of one player, are owned by the server.
+ */
+USTRUCT(BlueprintType)
+struct PROGRESSIONSYSTEMCORE_API FPSReplicatedRows : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/** Rows in the order of the progression data table */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "C++")
+	TArray<FPSReplicatedRow> Items;
+
+	/** The component that holds these rows, is notified about replicated changes */
+	UPROPERTY(NotReplicated, Transient)
+	TObjectPtr<class UPSReplicationComponent> OwnerComponent = nullptr;
+
+	/** Returns the index of the row by its name, INDEX_NONE if it's not found. */
+	int32 IndexOfRow(FName RowName) const;
+
+	/** Creates rows in the order of settings and fills them with the uploaded progression validated by these settings, rows are not marked dirty here.
+	 * Uses the same unlock rule as local saves: the first level is always unlocked, any other level is unlocked only if the previous one is unlocked and has enough points.
+	 * @param ProgressionSettings Settings of all rows of the server.
+	 * @param SavedRows The progression uploaded by the client, rows unknown to the server are skipped, missing rows are locked. */
+	void SeedRows(const TMap<FName, FPSRowData>& ProgressionSettings, const TArray<FPSReplicatedRow>& SavedRows);
+
+	/** Adds the reward to the row and unlocks the next row if enough points are achieved, rows are not marked dirty here.
+	 * @param RowIndex The row the match was played on.
+	 * @param RowSettings Settings of that row.
+	 * @param Reward Points to add.
+	 * @param OutChangedRowIndices Indices of changed rows, are the played row and the unlocked one at most. */
+	void AddReward(int32 RowIndex, const FPSRowData& RowSettings, float Reward, TArray<int32, TInlineAllocator<2>>& OutChangedRowIndices);
+
+	/** Serializes only changed rows. */
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FastArrayDeltaSerialize<FPSReplicatedRow, FPSReplicatedRows>(Items, DeltaParms, *this);
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FPSReplicatedRows> : public TStructOpsTypeTraitsBase2<FPSReplicatedRows>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * Makes the server the owner of the player's progression and replicates it to clients.
+ * Is added dynamically to the player states by the replication subsystem on the server of network games.
+ * Has no presentation, so it also runs on dedicated servers, the progression owner of the world writes replicated rows to local saves.
+ * Clients upload their saved progression once, then only the server applies end-game rewards,
+ * and clients write replicated rows back to their local save.
+ */
+UCLASS(Blueprintable, BlueprintType, ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class PROGRESSIONSYSTEMCORE_API UPSReplicationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UPSReplicationComponent();
+
+	/** Returns all replicated progression rows of the owning player. */
+	FORCEINLINE const FPSReplicatedRows& GetReplicatedRows() const { return ReplicatedRowsInternal; }
+
+	/** Returns the replicated progression of the level, is empty if the row is not replicated yet. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	const FPSSaveToDiskData& GetReplicatedRowByName(FName RowName) const;
+
+	/** Returns true if the owning player state belongs to a local player of this game instance. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	bool IsLocallyOwned() const;
+
+	/** Returns true once the server received the saved progression of the owning player. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE bool IsSeeded() const { return bIsSeededInternal; }
+
+	/** Sends the saved progression of the local player to the server, is called once the save is loaded.
+	 * Does nothing if it's already seeded, so the server keeps the authority for the rest of the session. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void UploadLocalProgression(class UPSSaveGameData* SaveGameData);
+
+	/** Adds points earned by an in-match event of the owning player, they are added together with the end-game reward of the match.
+	 * Is called only by the server that runs the match, clients never send their progress, so they can't change it.
+	 * The accumulated progress is kept between 0 and the max match progress of the replication subsystem. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "C++")
+	void AddMatchProgress(float Points);
+
+	/** Returns points earned by in-match events of the owning player since the match started, is known only by the server. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE float GetMatchProgress() const { return MatchProgressInternal; }
+
+	/** Is called when the row is changed on the server or received on the client, writes it to the local save if the owner is local. */
+	void OnRowReplicated(const FPSReplicatedRow& Row);
+
+protected:
+	/** Progression rows of the owning player, only changed rows are replicated */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Replicated, Category = "C++", meta = (BlueprintProtected, DisplayName = "Replicated Rows"))
+	FPSReplicatedRows ReplicatedRowsInternal;
+
+	/** Is set on the server once rows are created from the uploaded progression */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Replicated, Category = "C++", meta = (BlueprintProtected, DisplayName = "Is Seeded"))
+	bool bIsSeededInternal = false;
+
+	/** Points earned by in-match events of the owning player, are accumulated on the server and are never replicated */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Match Progress"))
+	float MatchProgressInternal = 0.f;
+
+	/** Is set once this component is registered as the replication component of the local player */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Is Registered Locally"))
+	bool bIsRegisteredLocallyInternal = false;
+
+	/** Returns properties that are replicated for the lifetime of the actor channel. */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Called when the game starts. */
+	virtual void BeginPlay() override;
+
+	/** Clears all transient data created by this component. */
+	virtual void OnUnregister() override;
+
+	/** Registers this component in the progression owner if the owning player is local, so the server becomes the authority of its progression. */
+	void TryRegisterLocally();
+
+	/** Receives the saved progression of the owning client, is applied only once. */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerUploadProgression(const TArray<FPSReplicatedRow>& SavedRows);
+
+	/** Creates rows in the order of the data table and fills them with the uploaded progression validated by the server's settings, is applied only once. */
+	void SeedRows(const TArray<FPSReplicatedRow>& SavedRows);
+
+	/** Is called on the server when the end-game state of the owning player is changed, the new match starts without in-match progress. */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
+	void OnEndGameStateChanged(EEndGameState EndGameState);
+
+	/** Adds the end-game reward and in-match progress to the row of the owning player's character and unlocks the next row if enough points are achieved. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "C++", meta = (BlueprintProtected))
+	void ApplyEndGameReward(EEndGameState EndGameState);
+
+	/** Adds the reward to the row on the server, unlocks the next row if enough points are achieved and marks changed rows to be replicated. */
+	void AddRowReward(int32 RowIndex, const FPSRowData& RowSettings, float Reward);
+
+	/** Returns the progression row of the owning player's character, none if the character is not possessed. */
+	FName GetOwnerRowName() const;
+
+	/** Marks the row to be replicated and applies it locally if the owner is the listen server player. */
+	void MarkRowDirty(FPSReplicatedRow& Row);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/** Network tests drive the server side of the upload and reward directly. */
+	friend struct FPSReplicationTestAccess;
+#endif
+};
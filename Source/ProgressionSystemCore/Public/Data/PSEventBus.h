@@ -0,0 +1,269 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Algo/BinarySearch.h"
+#include "Delegates/Delegate.h"
+#include "Structures/PlayerTag.h"
+
+/** Is broadcast when the current progression row is changed, e.g. when the character is switched. */
+struct FPSRowChangedEvent
+{
+	/** The new current progression row */
+	FName RowName = NAME_None;
+
+	/** The character of the new current row */
+	FPlayerTag PlayerTag = FPlayerTag::None;
+
+	/** The local player whose row is changed, 0 is the primary player */
+	int32 LocalPlayerIndex = 0;
+};
+
+/** Is broadcast when the achieved points of a level are changed. */
+struct FPSProgressChangedEvent
+{
+	/** The progression row which points are changed */
+	FName RowName = NAME_None;
+
+	/** Achieved points before the change */
+	float PreviousProgression = 0.f;
+
+	/** Achieved points after the change */
+	float NewProgression = 0.f;
+
+	/** The local player whose points are changed */
+	int32 LocalPlayerIndex = 0;
+};
+
+/** Is broadcast when a level is unlocked. */
+struct FPSLevelUnlockedEvent
+{
+	/** The unlocked progression row */
+	FName RowName = NAME_None;
+
+	/** The local player who unlocked the level */
+	int32 LocalPlayerIndex = 0;
+};
+
+/** Is broadcast once the save game is loaded and the progression is ready to be used, or once any initialization stage failed. */
+struct FPSInitializedEvent
+{
+	/** False if initialization failed, e.g. the data asset is not loaded, so the progression is not available in this world */
+	bool bIsSucceeded = true;
+};
+
+/** Is broadcast when the spot of the local character is ready. */
+struct FPSSpotReadyEvent
+{
+	/** The spot which is ready, is the spot component of the presentation module, so the core module doesn't depend on its type */
+	class UActorComponent* SpotComponent = nullptr;
+
+	/** The local player whose character is on this spot */
+	int32 LocalPlayerIndex = 0;
+};
+
+/**
+ * Dispatches one type of progression events to native listeners.
+ * Listeners are sorted by priority once on subscribe, so the broadcast only iterates them and never allocates.
+ * It's safe to subscribe and unsubscribe from inside the broadcast, such changes are applied once the broadcast is finished.
+ */
+template <typename TEvent>
+class TPSEventChannel
+{
+public:
+	using FHandler = TDelegate<void(const TEvent&)>;
+
+	/** Subscribes the handler, handlers with higher priority are called first, handlers with equal priority are called in subscription order.
+	 * @return the handle to unsubscribe the handler. */
+	FDelegateHandle Subscribe(FHandler&& Handler, int32 Priority = 0)
+	{
+		const FDelegateHandle Handle = Handler.GetHandle();
+		FListener NewListener{MoveTemp(Handler), Priority};
+		if (BroadcastDepth > 0)
+		{
+			// Listeners are not reordered while they are iterated
+			PendingListeners.Emplace(MoveTemp(NewListener));
+		}
+		else
+		{
+			InsertListener(MoveTemp(NewListener));
+		}
+		return Handle;
+	}
+
+	/** Unsubscribes the handler by its handle. */
+	void Unsubscribe(FDelegateHandle Handle)
+	{
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+
+		RemoveListeners([Handle](const FHandler& Handler) { return Handler.GetHandle() == Handle; });
+	}
+
+	/** Unsubscribes all handlers bound to the given object. */
+	void UnsubscribeAll(const void* UserObject)
+	{
+		if (!UserObject)
+		{
+			return;
+		}
+
+		RemoveListeners([UserObject](const FHandler& Handler) { return Handler.IsBoundToObject(UserObject); });
+	}
+
+	/** Returns true if any handler is bound to the given object. */
+	bool IsSubscribed(const void* UserObject) const
+	{
+		const auto IsBoundToObject = [UserObject](const FListener& Listener) { return !Listener.bIsRemoved && Listener.Handler.IsBoundToObject(UserObject); };
+		return Listeners.ContainsByPredicate(IsBoundToObject) || PendingListeners.ContainsByPredicate(IsBoundToObject);
+	}
+
+	/** Calls all subscribed handlers by their priority. */
+	void Broadcast(const TEvent& Event)
+	{
+		++BroadcastDepth;
+
+		// Listeners subscribed during the broadcast are pending, so the amount is not changed while iterating
+		const int32 ListenersNum = Listeners.Num();
+		for (int32 Index = 0; Index < ListenersNum; ++Index)
+		{
+			const FListener& Listener = Listeners[Index];
+			if (!Listener.bIsRemoved)
+			{
+				Listener.Handler.ExecuteIfBound(Event);
+			}
+		}
+
+		--BroadcastDepth;
+		if (BroadcastDepth == 0)
+		{
+			ApplyPendingChanges();
+		}
+	}
+
+	/** Removes all handlers. */
+	void Reset()
+	{
+		if (BroadcastDepth > 0)
+		{
+			RemoveListeners([](const FHandler&) { return true; });
+			return;
+		}
+
+		Listeners.Empty();
+		PendingListeners.Empty();
+		bHasRemovedListeners = false;
+	}
+
+private:
+	/** A subscribed handler with its priority. */
+	struct FListener
+	{
+		FHandler Handler;
+		int32 Priority = 0;
+
+		/** Is set when the handler is unsubscribed during the broadcast, it's kept bound since it might be executing */
+		bool bIsRemoved = false;
+	};
+
+	/** Handlers sorted by priority from the highest one. */
+	TArray<FListener> Listeners;
+
+	/** Handlers subscribed during the broadcast, are added once the broadcast is finished. */
+	TArray<FListener> PendingListeners;
+
+	/** Amount of broadcasts in progress, is greater than 1 if an event is broadcast from its own handler. */
+	int32 BroadcastDepth = 0;
+
+	/** True if any handler was unsubscribed during the broadcast and has to be removed. */
+	bool bHasRemovedListeners = false;
+
+	/** Inserts the listener after all listeners with the same or higher priority. */
+	void InsertListener(FListener&& Listener)
+	{
+		const int32 InsertIndex = Algo::UpperBoundBy(Listeners, Listener.Priority, &FListener::Priority, TGreater<>());
+		Listeners.Insert(MoveTemp(Listener), InsertIndex);
+	}
+
+	/** Removes handlers matching the predicate, they are only marked as removed while the broadcast is in progress. */
+	template <typename TPredicate>
+	void RemoveListeners(TPredicate Predicate)
+	{
+		PendingListeners.RemoveAll([&Predicate](const FListener& Listener) { return Predicate(Listener.Handler); });
+
+		if (BroadcastDepth > 0)
+		{
+			for (FListener& Listener : Listeners)
+			{
+				if (Predicate(Listener.Handler))
+				{
+					Listener.bIsRemoved = true;
+					bHasRemovedListeners = true;
+				}
+			}
+			return;
+		}
+
+		Listeners.RemoveAll([&Predicate](const FListener& Listener) { return Predicate(Listener.Handler); });
+	}
+
+	/** Removes handlers unsubscribed during the broadcast and adds handlers subscribed during it. */
+	void ApplyPendingChanges()
+	{
+		if (bHasRemovedListeners)
+		{
+			Listeners.RemoveAll([](const FListener& Listener) { return Listener.bIsRemoved; });
+			bHasRemovedListeners = false;
+		}
+
+		for (FListener& PendingListener : PendingListeners)
+		{
+			InsertListener(MoveTemp(PendingListener));
+		}
+		PendingListeners.Reset();
+	}
+};
+
+/**
+ * Native progression events, is owned by the world subsystem.
+ * C++ systems (e.g. achievements or analytics) subscribe here with typed payloads instead of the dynamic delegates,
+ * the dynamic delegates of the subsystem are Blueprint adapters subscribed to this bus.
+ */
+struct FPSEventBus
+{
+	using FRowChangedHandler = TPSEventChannel<FPSRowChangedEvent>::FHandler;
+	using FProgressChangedHandler = TPSEventChannel<FPSProgressChangedEvent>::FHandler;
+	using FLevelUnlockedHandler = TPSEventChannel<FPSLevelUnlockedEvent>::FHandler;
+	using FInitializedHandler = TPSEventChannel<FPSInitializedEvent>::FHandler;
+	using FSpotReadyHandler = TPSEventChannel<FPSSpotReadyEvent>::FHandler;
+
+	/** Priority of Blueprint adapters, they are called after all native handlers */
+	static constexpr int32 BlueprintAdapterPriority = MIN_int32;
+
+	/** Is broadcast when the current progression row is changed */
+	TPSEventChannel<FPSRowChangedEvent> RowChanged;
+
+	/** Is broadcast when the achieved points of a level are changed */
+	TPSEventChannel<FPSProgressChangedEvent> ProgressChanged;
+
+	/** Is broadcast when a level is unlocked */
+	TPSEventChannel<FPSLevelUnlockedEvent> LevelUnlocked;
+
+	/** Is broadcast once the save game is loaded */
+	TPSEventChannel<FPSInitializedEvent> Initialized;
+
+	/** Is broadcast when the spot of the local character is ready */
+	TPSEventChannel<FPSSpotReadyEvent> SpotReady;
+
+	/** Removes all handlers of all events */
+	void Reset()
+	{
+		RowChanged.Reset();
+		ProgressChanged.Reset();
+		LevelUnlocked.Reset();
+		Initialized.Reset();
+		SpotReady.Reset();
+	}
+};
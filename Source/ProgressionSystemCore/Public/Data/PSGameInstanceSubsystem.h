@@ -0,0 +1,66 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Data/PSCoreTypes.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "PSGameInstanceSubsystem.generated.h"
+
+/**
+ * Owns the progression state that has to survive map travel: settings of the data table and loaded save profiles.
+ * World subsystems keep only the per-world presentation and take the state from here,
+ * so returning to the main menu after a match doesn't read the save from disk again.
+ */
+UCLASS(BlueprintType, Blueprintable)
+class PROGRESSIONSYSTEMCORE_API UPSGameInstanceSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of the game instance of given object's world, is null if the world has no game instance (e.g. editor preview worlds). */
+	static UPSGameInstanceSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Returns settings of all progression rows, are copied from the given data table once per game instance. */
+	const TMap<FName, FPSRowData>& GetOrLoadProgressionSettings(const class UDataTable* ProgressionDataTable);
+
+	/** Returns settings of all progression rows if they are already copied from the data table, is empty otherwise and never loads anything. */
+	FORCEINLINE const TMap<FName, FPSRowData>& GetProgressionSettings() const { return ProgressionSettingsDataInternal; }
+
+	/** Returns the save profile that is already loaded to the given slot in this game instance, is null if it was never loaded. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	class UPSSaveGameData* FindSaveGame(const FString& SlotName) const;
+
+	/** Keeps the loaded or created save profile of the slot for the whole game instance, null removes it. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SetSaveGame(const FString& SlotName, class UPSSaveGameData* SaveGameData);
+
+	/** Keeps the loaded save as the profile of the slot, creates a new one with all rows of settings if it failed to load.
+	 * @param SlotName The slot the save was loaded from.
+	 * @param LoadedSaveGame The loaded save, is null if there is no save file or it is corrupted.
+	 * @param ProgressionOwner The world that applies progression changes of this profile, is set again for the profile loaded by the previous world.
+	 * @param LocalPlayerIndex The local player who owns this profile.
+	 * @return the profile of the slot, is null only if the save object can't be created. */
+	class UPSSaveGameData* AcquireSaveGame(const FString& SlotName, class USaveGame* LoadedSaveGame, class IPSProgressionOwner& ProgressionOwner, int32 LocalPlayerIndex);
+
+	/** Deletes the save file of the slot and replaces its profile by the new one with all rows of settings locked. */
+	class UPSSaveGameData* ResetSaveGame(const FString& SlotName, class IPSProgressionOwner& ProgressionOwner, int32 LocalPlayerIndex);
+
+	/** Writes the profile of the slot to disk on a worker thread, does nothing if the slot has no profile. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SaveGameAsync(const FString& SlotName, int32 LocalPlayerIndex) const;
+
+protected:
+	/** Settings of all progression rows copied from the data table, are never changed later */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression Settings Data"))
+	TMap<FName, FPSRowData> ProgressionSettingsDataInternal;
+
+	/** Loaded save profiles by their slot names, there are few of them in split-screen */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Save Games"))
+	TMap<FString, TObjectPtr<class UPSSaveGameData>> SaveGamesInternal;
+
+	/** Adds all rows of settings to the profile as locked levels without progress. */
+	void ResetProgressionRows(class UPSSaveGameData& SaveGameData) const;
+
+	/** Clears all state owned by this subsystem. */
+	virtual void Deinitialize() override;
+};
@@ -0,0 +1,54 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
+
+/**
+ * Accumulates progress points earned by in-match events (kills, pickups, survival time) of each local player.
+ * Posting is lock-free and can be done from any thread at high rates: it only adds to the atomic fixed-point counter of the player.
+ * The game thread takes posted points once per frame, they are committed to the save profile once at match end.
+ * @see UPSWorldSubsystem::PostMatchProgress
+ */
+class PROGRESSIONSYSTEMCORE_API FPSProgressAccumulator
+{
+public:
+	/** Maximum amount of local players that can post progress, posts of other players are ignored */
+	static constexpr int32 MaxLocalPlayers = 8;
+
+	/** Points are stored as integers with this scale, so concurrent additions are exact and don't depend on their order */
+	static constexpr int64 FixedPointScale = 1000;
+
+	/** Adds points to the local player, is safe to call from any thread. Negative points are allowed to apply penalties. */
+	void Post(int32 LocalPlayerIndex, float Points);
+
+	/** Returns true if any points were posted since the last consume, is cheap to check every frame. */
+	FORCEINLINE bool HasPendingPoints() const { return bHasPendingPoints.load(std::memory_order_relaxed); }
+
+	/** Clears the pending flag before consuming, so points posted while consuming are taken on the next call. */
+	FORCEINLINE void ClearPendingPoints() { bHasPendingPoints.store(false, std::memory_order_relaxed); }
+
+	/** Takes all points posted to the local player since the last call, is called on the game thread. */
+	float Consume(int32 LocalPlayerIndex);
+
+	/** Discards all posted points, e.g. when a new match is started. */
+	void Reset();
+
+private:
+	/** The counter of one local player, is aligned to the cache line, so threads posting to different players don't contend */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FPlayerSlot
+	{
+		std::atomic<int64> FixedPoints{0};
+	};
+
+	/** Posted points of each local player by the local player index */
+	FPlayerSlot PlayerSlots[MaxLocalPlayers];
+
+	/** Is set by any post and cleared by the game thread before consuming */
+	std::atomic<bool> bHasPendingPoints{false};
+};
+
+/** Shared reference to the accumulator, tasks keep it alive while posting even if the world is torn down */
+using FPSProgressAccumulatorRef = TSharedRef<FPSProgressAccumulator, ESPMode::ThreadSafe>;
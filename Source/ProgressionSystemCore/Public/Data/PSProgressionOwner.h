@@ -0,0 +1,50 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Data/PSCoreTypes.h"
+#include "UObject/Interface.h"
+#include "PSProgressionOwner.generated.h"
+
+struct FPSEventBus;
+class UPSReplicationComponent;
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UPSProgressionOwner : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Owns the progression of local players in one world: knows their current rows and the reward multiplier, and dispatches progression events.
+ * Save profiles apply rewards and unlocks through this interface, so the core module doesn't depend on the presentation.
+ * Replication components of local players write rows received from the server through it as well.
+ * @see UPSSaveGameData::SetProgressionOwner
+ * @see UPSReplicationSubsystem::SetProgressionOwner
+ */
+class PROGRESSIONSYSTEMCORE_API IPSProgressionOwner
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the current progression row of the local player. */
+	virtual FName GetProgressionRowName(int32 LocalPlayerIndex) const = 0;
+
+	/** Returns settings of the current progression row of the local player. */
+	virtual const FPSRowData& GetProgressionRowSettings(int32 LocalPlayerIndex) const = 0;
+
+	/** Returns the multiplier applied to all end-game rewards, e.g. by the game difficulty. */
+	virtual float GetProgressionRewardMultiplier() const = 0;
+
+	/** Returns native progression events. */
+	virtual FPSEventBus& GetProgressionEventBus() = 0;
+
+	/** Sets the component that replicates the progression of the local player owning it, the server becomes the authority of this player's progression. */
+	virtual void SetProgressionReplication(UPSReplicationComponent* ReplicationComponent) = 0;
+
+	/** Removes the replication component from the local player it was set for, the progression is applied locally again. */
+	virtual void RemoveProgressionReplication(const UPSReplicationComponent* ReplicationComponent) = 0;
+
+	/** Writes the row received from the server to the save profile of the local player owning the replication component. */
+	virtual void ApplyReplicatedProgressionRow(const UPSReplicationComponent* ReplicationComponent, FName RowName, const FPSSaveToDiskData& NewSaveToDiskData) = 0;
+};
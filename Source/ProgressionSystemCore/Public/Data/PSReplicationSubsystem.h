@@ -0,0 +1,86 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Data/PSCoreTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/WeakInterfacePtr.h"
+#include "PSReplicationSubsystem.generated.h"
+
+enum class EGameDifficulty : uint8;
+
+/**
+ * Makes the server the owner of each player's progression in network games, has no presentation, so it also runs on dedicated servers.
+ * Adds the replication component to each player state and gives it settings and the reward multiplier.
+ * The presentation module registers itself as the progression owner, so replicated rows are written to local saves.
+ * @see UPSReplicationComponent
+ */
+UCLASS(BlueprintType, Blueprintable, Config = "ProgressionSystem", DefaultConfig)
+class PROGRESSIONSYSTEMCORE_API UPSReplicationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of given object's world, is null if the world has no subsystems. */
+	static UPSReplicationSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Returns the subsystem of given object's world, is checked. */
+	static UPSReplicationSubsystem& GetChecked(const UObject& WorldContextObject);
+
+	/** Sets the world object that applies replicated rows to local saves, null if there is no presentation, e.g. on dedicated servers. */
+	void SetProgressionOwner(class IPSProgressionOwner* NewProgressionOwner);
+
+	/** Returns the world object that applies replicated rows to local saves, is null if there is no presentation. */
+	FORCEINLINE class IPSProgressionOwner* GetProgressionOwner() const { return ProgressionOwnerInternal.Get(); }
+
+	/** Returns settings of all progression rows, are copied from the data table once per game instance. */
+	const TMap<FName, FPSRowData>& GetProgressionSettings() const;
+
+	/** Returns the multiplier of end-game rewards, is taken from the progression owner, or from the config if there is no owner. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	float GetRewardMultiplier() const;
+
+	/** Returns the maximum amount of points the player can earn by in-match events during one match. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE float GetMaxMatchProgress() const { return MaxMatchProgressInternal; }
+
+	/** Adds points earned by an in-match event (e.g. kill, pickup or survival time) of the player, is called by the server that runs the match.
+	 * Points are added together with the end-game reward, does nothing if the player state has no replication component. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "C++")
+	void AddMatchProgress(class APlayerState* PlayerState, float Points);
+
+	/** Adds the replication component to the player state if it has none, is done by the server for each player in network games. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "C++")
+	void AddReplicationComponent(class APlayerState* PlayerState);
+
+protected:
+	/** The progression data table the server validates and rewards by, is the same table as the one of the progression data asset.
+	 * Is configured here, so dedicated servers don't load the presentation assets. */
+	UPROPERTY(Config, VisibleDefaultsOnly, BlueprintReadOnly, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression Data Table"))
+	TSoftObjectPtr<const class UDataTable> ProgressionDataTableInternal;
+
+	/** The multiplier of end-game rewards by the game difficulty, is used only if there is no progression owner, e.g. on dedicated servers.
+	 * Rewards are not scaled if the difficulty is not found. */
+	UPROPERTY(Config, VisibleDefaultsOnly, BlueprintReadOnly, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression Difficulty Multiplier"))
+	TMap<EGameDifficulty, float> ProgressionDifficultyMultiplierInternal;
+
+	/** The maximum amount of points the player can earn by in-match events during one match, the accumulated progress is clamped by it.
+	 * Bounds the progress of each match, so in-match events can't unlock more levels than planned. */
+	UPROPERTY(Config, VisibleDefaultsOnly, BlueprintReadOnly, Category = "C++", meta = (BlueprintProtected, DisplayName = "Max Match Progress", ClampMin = "0"))
+	float MaxMatchProgressInternal = 1.f;
+
+	/** The world object that applies replicated rows to local saves */
+	TWeakInterfacePtr<class IPSProgressionOwner> ProgressionOwnerInternal = nullptr;
+
+	/** Handle of the listener of spawned player states, is registered only on the server of network games */
+	FDelegateHandle ActorSpawnedHandleInternal;
+
+	/** Adds the replication component to all player states on the server of network games. */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Clears all transient data created by this subsystem. */
+	virtual void Deinitialize() override;
+
+	/** Adds the replication component to each spawned player state, is called on the server of network games. */
+	void OnActorSpawned(AActor* SpawnedActor);
+};
@@ -0,0 +1,106 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Data/PSCoreTypes.h"
+#include "GameFramework/SaveGame.h"
+#include "UObject/WeakInterfacePtr.h"
+#include "PSSaveGameData.generated.h"
+
+
+/**
+ * Defines the standard process for the saving slots names and index 
+ */
+UCLASS()
+class PROGRESSIONSYSTEMCORE_API UPSSaveGameData : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the base name of the save slot, the world subsystem may append a per-world suffix to it.
+	 * @see UPSWorldSubsystem::GetSaveSlotName */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	static const FString& GetSaveSlotName();
+
+	/** Returns the Slot Index of the save slot. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	static int32 GetSaveSlotIndex() { return 0; }
+
+	/** Sets the owner of the progression in the world this save belongs to, so progression changes are applied to that world only.
+	 * @param InProgressionOwner Usually the world subsystem of the presentation module.
+	 * @param InLocalPlayerIndex The local player who owns this save, its current row is used for the progression changes. */
+	void SetProgressionOwner(class IPSProgressionOwner* InProgressionOwner, int32 InLocalPlayerIndex = 0);
+
+	/** Returns the local player who owns this save. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE int32 GetLocalPlayerIndex() const { return LocalPlayerIndexInternal; }
+
+	/** Returns the Slot Index of the save slot. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE TMap<FName, FPSSaveToDiskData>& GetProgressionSettingsRowDataInternal() { return ProgressionSettingsRowDataInternal; }
+
+	/** Returns the ProgressionRow by Index */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FName GetSavedProgressionRowByIndex(int32 Index) const;
+
+	/** Update the ProgressionRows map */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SetProgressionMap(FName RowName, const FPSSaveToDiskData& ProgressionRows);
+
+	/** Unlock level by Index, used only for the first level
+	 * @return true if the level was locked before, so the profile has to be saved. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	bool UnlockLevelByName(FName RowName);
+
+	/** Adds the end game reward to the current level of the owning player, it's not saved to disk here.
+	 * @param MatchProgress Points earned by in-match events, are added as is together with the reward. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void AddEndGamePoints(EEndGameState EndGameState, float MatchProgress = 0.f);
+
+	/** Is kept for existing callers: adds the end game reward as AddEndGamePoints does, but the profile is not saved to disk anymore. */
+	UFUNCTION(BlueprintCallable, Category = "C++", meta = (DeprecatedFunction, DeprecationMessage = "Call AddEndGamePoints, the profile is not saved to disk here anymore: queue the result by the HUD component, so it's saved by the next progression flush"))
+	void SavePoints(EEndGameState EndGameState);
+
+	/** Unlocks the next level*/
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void NextLevelProgressionRowData();
+
+	/** Unlocks all levels and set maximum allowed progression points */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void UnlockAllLevels();
+
+	/** Returns the endgame reward. */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	float GetProgressionReward(EEndGameState EndGameState);
+
+	/** Returns the endgame reward of the level, is the single formula for local saves and the server.
+	 * @param RowSettings Settings of the level the match was played on.
+	 * @param EndGameState The result of the match.
+	 * @param RewardMultiplier The multiplier of all rewards, e.g. by the game difficulty. */
+	UFUNCTION(BlueprintPure, Category="C++")
+	static float CalculateProgressionReward(const FPSRowData& RowSettings, EEndGameState EndGameState, float RewardMultiplier);
+
+	/** Returns true if enough points are achieved on the level to unlock the next one, is the single rule for local saves and the server. */
+	UFUNCTION(BlueprintPure, Category="C++")
+	static bool ShouldUnlockNextLevel(const FPSRowData& RowSettings, float LevelProgression);
+
+	/** Returns the current save to disk data by name. */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	const FPSSaveToDiskData& GetSaveToDiskDataByName(FName CurrentRowName) const;
+
+protected:
+	/** The current Saved Progression of a player. */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Saved Progression Rows"))
+	TMap<FName, FPSSaveToDiskData> ProgressionSettingsRowDataInternal;
+
+	/** The owner of the progression in the world this save belongs to, is not saved to disk.
+	 * Is weak since the save is kept by the game instance while worlds are changed. */
+	TWeakInterfacePtr<class IPSProgressionOwner> ProgressionOwnerInternal;
+
+	/** The local player who owns this save, is not saved to disk */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Local Player Index"))
+	int32 LocalPlayerIndexInternal = 0;
+
+	/** Returns the owner of the progression in the world this save belongs to, is null if the owner is not set or its world is destroyed. */
+	class IPSProgressionOwner* GetProgressionOwner() const;
+};
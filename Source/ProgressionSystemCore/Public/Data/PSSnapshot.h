@@ -0,0 +1,102 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Data/PSCoreTypes.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
+
+/** Achieved points and the lock state of each level, is shared by snapshots until the rows are changed */
+using FPSSnapshotRowsPtr = TSharedPtr<const TMap<FName, FPSSaveToDiskData>, ESPMode::ThreadSafe>;
+
+/** Points required to unlock each level, is shared by snapshots until settings are changed */
+using FPSSnapshotPointsPtr = TSharedPtr<const TMap<FName, float>, ESPMode::ThreadSafe>;
+
+/**
+ * Immutable progression of one local player at the moment the snapshot was published.
+ */
+struct PROGRESSIONSYSTEMCORE_API FPSPlayerSnapshot
+{
+	/** The current progression row of the player */
+	FName CurrentRowName = NAME_None;
+
+	/** Achieved points and the lock state of each level, is null if the save of the player is not loaded */
+	FPSSnapshotRowsPtr Rows;
+};
+
+/**
+ * Immutable and versioned copy of the progression of all local players.
+ * Is published by the world subsystem after each committed change and is never modified after that,
+ * so it can be read from any thread without locks, e.g. by async loading decisions or analytics tasks.
+ * Unchanged rows are shared with the previous snapshot, so switching the current row does not copy them.
+ * @see UPSWorldSubsystem::GetProgressionSnapshotPublisher
+ */
+struct PROGRESSIONSYSTEMCORE_API FPSProgressionSnapshot
+{
+	/** Incremented on each publish, readers compare it to skip unchanged snapshots */
+	uint64 Version = 0;
+
+	/** Progression of each local player by the local player index */
+	TArray<FPSPlayerSnapshot> Players;
+
+	/** Points required to unlock each level, are copied from the progression data table, is null if settings are not loaded */
+	FPSSnapshotPointsPtr PointsToUnlock;
+
+	/** Returns the progression of the local player, is empty if the player is not tracked. */
+	const FPSPlayerSnapshot& GetPlayer(int32 LocalPlayerIndex = 0) const;
+
+	/** Returns the saved data of the row of the local player, is empty if the row is not found. */
+	const FPSSaveToDiskData& GetRow(FName RowName, int32 LocalPlayerIndex = 0) const;
+
+	/** Returns the saved data of the current row of the local player. */
+	const FPSSaveToDiskData& GetCurrentRow(int32 LocalPlayerIndex = 0) const;
+
+	/** Returns the points required to unlock the level, 0 if the row is not found. */
+	float GetPointsToUnlock(FName RowName) const;
+
+private:
+	/** Returned for players that are not tracked. */
+	static const FPSPlayerSnapshot EmptyPlayer;
+};
+
+/** Shared pointer to the published snapshot, is safe to copy between threads */
+using FPSProgressionSnapshotPtr = TSharedPtr<const FPSProgressionSnapshot, ESPMode::ThreadSafe>;
+
+/**
+ * Publishes progression snapshots to readers on any thread without locks.
+ * Snapshots are kept in the small fixed ring of slots, the published slot is swapped atomically.
+ * Each slot counts readers that are copying its pointer, so the writer never overwrites or releases a slot while it's read.
+ * Each publish releases all replaced snapshots that are not being copied, so at most SlotsNum snapshots are kept alive by the publisher.
+ */
+class PROGRESSIONSYSTEMCORE_API FPSSnapshotPublisher
+{
+public:
+	/** Amount of slots, readers only copy the pointer, so the writer almost never waits for a free slot */
+	static constexpr int32 SlotsNum = 4;
+
+	/** Returns the last published snapshot, is safe to call from any thread. Is null if nothing is published yet. */
+	FPSProgressionSnapshotPtr Get() const;
+
+	/** Replaces the published snapshot, is called by one writer thread only. */
+	void Publish(const FPSProgressionSnapshotPtr& NewSnapshot);
+
+private:
+	/** One published or replaced snapshot */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+	{
+		/** Is written by the writer only while the slot is not published and not read */
+		FPSProgressionSnapshotPtr Snapshot;
+
+		/** Amount of readers copying the pointer of this slot at the moment */
+		mutable std::atomic<int32> ReadersNum{0};
+	};
+
+	/** Snapshots of the ring */
+	FSlot Slots[SlotsNum];
+
+	/** The index of the published slot */
+	std::atomic<int32> PublishedSlotIndex{0};
+};
+
+/** Shared reference to the publisher, worker tasks keep it alive while reading even if the world is torn down */
+using FPSSnapshotPublisherRef = TSharedRef<FPSSnapshotPublisher, ESPMode::ThreadSafe>;
@@ -0,0 +1,18 @@
+﻿// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Modules/ModuleInterface.h"
+
+/**
+ * Contains the progression data, save, reward and unlock logic without any UI dependencies.
+ * The presentation (widgets, star actors, HUD component) is implemented by the ProgressionSystemRuntime module.
+ */
+class PROGRESSIONSYSTEMCORE_API FProgressionSystemCoreModule : public IModuleInterface
+{
+public:
+	//~IModuleInterface
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+	//~End of IModuleInterface
+};
@@ -40,14 +40,24 @@ void UPSHUDComponent::OnInitialized_Implementation()
 	// Listen to handle input for each game state
 	BIND_ON_GAME_STATE_CHANGED(this, ThisClass::OnGameStateChanged);
 
-	// Subscribe to the event notifying changes in player type
-	UPSWorldSubsystem::Get().OnCurrentRowDataChanged.AddDynamic(this, &ThisClass::OnPlayerTypeChanged);
+	// Subscribe to the event notifying changes in player type of this local player only
+	TPSEventChannel<FPSRowChangedEvent>& RowChangedEvent = GetPSContext().GetSubsystemChecked().GetEventBus().RowChanged;
+	if (!RowChangedEvent.IsSubscribed(this))
+	{
+		RowChangedEvent.Subscribe(FPSEventBus::FRowChangedHandler::CreateWeakLambda(this, [this](const FPSRowChangedEvent& Event)
+		{
+			if (Event.LocalPlayerIndex == GetPSContext().GetLocalPlayerIndex())
+			{
+				OnPlayerTypeChanged(Event.PlayerTag);
+			}
+		}));
+	}
 
 	// Save reference of this component to the world subsystem
-	UPSWorldSubsystem::Get().SetHUDComponent(this);
+	GetPSContext().GetSubsystemChecked().SetHUDComponent(this);
 
 	// Update the progression widget based on current player state
-	UpdateProgressionWidgetForPlayer();
+	GetPSContext().GetSubsystemChecked().MarkProgressionDirty(EPSDirtyFlags::MenuWidget | EPSDirtyFlags::Overlay);
 }
 
 // Subscribes to the end game state change notification on the player state.
@@ -58,6 +68,12 @@ void UPSHUDComponent::OnLocalPlayerStateReady_Implementation(AMyPlayerState* Pla
 	{
 		return;
 	}
+
+	// In split-screen each HUD listens only to the end game of its own player
+	if (GetPSContext().GetSubsystemChecked().GetLocalPlayerIndex(PlayerState) != GetPSContext().GetLocalPlayerIndex())
+	{
+		return;
+	}
 	PlayerState->OnEndGameStateChanged.AddUniqueDynamic(this, &ThisClass::OnEndGameStateChanged);
 }
 
@@ -75,7 +91,26 @@ void UPSHUDComponent::OnUnregister()
 {
 	Super::OnUnregister();
 
-	UPSWorldSubsystem::Get().PerformCleanUp();
+	// Subsystem might be already deinitialized if the world is torn down
+	if (UPSWorldSubsystem* WorldSubsystem = GetPSContext().GetSubsystem())
+	{
+		if (ProgressionMenuWidgetInternal)
+		{
+			// Star widgets are kept in the pool to be reused by the next menu widget
+			ProgressionMenuWidgetInternal->ReleaseStarWidgets();
+		}
+
+		FPSEventBus& EventBus = WorldSubsystem->GetEventBus();
+		EventBus.RowChanged.UnsubscribeAll(this);
+		EventBus.Initialized.UnsubscribeAll(this);
+
+		// The progression of the world is cleaned up by the primary player, others only stop listening
+		if (GetPSContext().GetLocalPlayerIndex() == 0)
+		{
+			WorldSubsystem->PerformCleanUp();
+		}
+	}
+	ResetPSContext();
 
 	if (ProgressionMenuWidgetInternal)
 	{
@@ -93,17 +128,16 @@ void UPSHUDComponent::OnUnregister()
 	}
 }
 
-// Save the progression depends on EEndGameState
+// Queues the end game result of this local player, results of all players are saved together by the progression flush
 void UPSHUDComponent::SavePoints(EEndGameState EndGameState)
 {
-	// @h4rdmol to move to Subsystem instead of hud
-	const UPSSaveGameData* SaveGameInstance = UPSWorldSubsystem::Get().GetCurrentSaveGameData();
-	if (!ensureMsgf(SaveGameInstance, TEXT("ASSERT: [%i] %hs:\n'SaveGameInstance' is null!"), __LINE__, __FUNCTION__))
+	UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
+	const int32 LocalPlayerIndex = GetPSContext().GetLocalPlayerIndex();
+	if (!ensureMsgf(WorldSubsystem.GetCurrentSaveGameData(LocalPlayerIndex), TEXT("ASSERT: [%i] %hs:\n'SaveGameData' is null!"), __LINE__, __FUNCTION__))
 	{
 		return;
 	}
-	UPSSaveGameData* SaveGameData = UPSWorldSubsystem::Get().GetCurrentSaveGameData();
-	SaveGameData->SavePoints(EndGameState);
+	WorldSubsystem.QueueEndGameResult(LocalPlayerIndex, EndGameState);
 }
 
 // Listening game states changes events 
@@ -112,7 +146,7 @@ void UPSHUDComponent::OnGameStateChanged_Implementation(ECurrentGameState Curren
 	switch (CurrentGameState)
 	{
 	case ECurrentGameState::Menu:
-		UpdateProgressionWidgetForPlayer();
+		GetPSContext().GetSubsystemChecked().MarkProgressionDirty(EPSDirtyFlags::MenuWidget | EPSDirtyFlags::Overlay);
 		break;
 	default: break;
 	}
@@ -123,64 +157,125 @@ void UPSHUDComponent::OnEndGameStateChanged_Implementation(EEndGameState EndGame
 {
 	if (EndGameState != EEndGameState::None)
 	{
+		// Earned stars are counted up by the subsystem once the queued result is applied
+		UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
 		SavePoints(EndGameState);
+
 		// show the stars widget at the bottom.
 		DisplayLevelUIOverlay(false); // isLevelLocked to show/hide the level blocking overlay with padlock icon at InGame state always level locked is false
 
-		UpdateProgressionWidgetForPlayer();
+		// End-game is the first time the menu widget is needed if it's disabled in the main menu
+		const bool bIsFirstDisplay = !ProgressionMenuWidgetInternal;
+		UPSMenuWidget& MenuWidget = GetOrCreateMenuWidget();
+		if (bIsFirstDisplay)
+		{
+			// Just created widget missed the end game state change, so show it in the end-game position here
+			MenuWidget.SetMenuWidgetShown(true);
+			MenuWidget.SetEndGamePosition(true);
+		}
+
+		WorldSubsystem.MarkProgressionDirty(EPSDirtyFlags::MenuWidget | EPSDirtyFlags::Overlay);
 	}
 }
 
 // Handle events when player type changes
 void UPSHUDComponent::OnPlayerTypeChanged_Implementation(FPlayerTag PlayerTag)
 {
-	UpdateProgressionWidgetForPlayer();
+	GetPSContext().GetSubsystemChecked().MarkProgressionDirty(EPSDirtyFlags::MenuWidget | EPSDirtyFlags::Overlay);
 }
 
 // Refresh the main menu progression widget player 
 void UPSHUDComponent::UpdateProgressionWidgetForPlayer()
 {
-	UPSSaveGameData* SaveGameData = UPSWorldSubsystem::Get().GetCurrentSaveGameData();
+	UpdateProgressionMenuWidget();
+	UpdateLevelUIOverlay();
+}
+
+// Creates, shows and updates the stars of the progression menu widget, is called by the progression flush
+void UPSHUDComponent::UpdateProgressionMenuWidget()
+{
+	const UPSSaveGameData* SaveGameData = GetPSContext().GetSubsystemChecked().GetCurrentSaveGameData(GetPSContext().GetLocalPlayerIndex());
 	if (!SaveGameData)
 	{
 		return;
 	}
 
-	const FPSSaveToDiskData& CurrenSaveToDiskDataRow = UPSWorldSubsystem::Get().GetCurrentSaveToDiskRowByName();
-	const FPSRowData& CurrenProgressionSettingsRow = UPSWorldSubsystem::Get().GetCurrentProgressionSettingsRowByName();
-	// check if empty returned Row from GetCurrentRow
-	if (!ensureMsgf(ProgressionMenuWidgetInternal, TEXT("ASSERT: [%i] %hs:\n'ProgressionMenuWidgetInternal' is null!"), __LINE__, __FUNCTION__))
+	const bool bIsInMenu = GetPSContext().GetSubsystemChecked().GetCurrentGameState() == ECurrentGameState::Menu;
+
+	// The menu widget is created only when it has to be displayed for the first time
+	if (bIsInMenu && PSMenuWidgetEnabledInternal)
+	{
+		GetOrCreateMenuWidget();
+	}
+
+	if (ProgressionMenuWidgetInternal)
+	{
+		UpdateProgressionStars();
+
+		if (bIsInMenu)
+		{
+			ProgressionMenuWidgetInternal->SetEndGamePosition(false);
+
+			if (PSMenuWidgetEnabledInternal)
+			{
+				ProgressionMenuWidgetInternal->SetMenuWidgetShown(true);
+			}
+		}
+	}
+}
+
+// Shows or hides the level overlay by the lock state of the current level, is called by the progression flush
+void UPSHUDComponent::UpdateLevelUIOverlay()
+{
+	if (!GetPSContext().GetSubsystemChecked().GetCurrentSaveGameData(GetPSContext().GetLocalPlayerIndex()))
+	{
+		return;
+	}
+
+	DisplayLevelUIOverlay(GetPSContext().GetCurrentPresentation().bIsLevelLocked);
+}
+
+// Updates only the stars of the menu widget by the displayed level progression, is called by the stars count-up every frame
+void UPSHUDComponent::UpdateProgressionStars()
+{
+	UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
+	const int32 LocalPlayerIndex = GetPSContext().GetLocalPlayerIndex();
+	if (!ProgressionMenuWidgetInternal || !WorldSubsystem.GetCurrentSaveGameData(LocalPlayerIndex))
 	{
 		return;
 	}
 
-	//set updated amount of stars
-	if (CurrenSaveToDiskDataRow.CurrentLevelProgression >= CurrenProgressionSettingsRow.PointsToUnlock)
+	const bool bIsInMenu = GetPSContext().GetSubsystemChecked().GetCurrentGameState() == ECurrentGameState::Menu;
+	if (bIsInMenu && !PSMenuWidgetEnabledInternal)
 	{
-		// set required points (stars)  to achieve for a level  
-		ProgressionMenuWidgetInternal->AddImagesToHorizontalBox(CurrenProgressionSettingsRow.PointsToUnlock, 0, CurrenProgressionSettingsRow.PointsToUnlock);
+		// Stars are not displayed in the main menu
+		ProgressionMenuWidgetInternal->AddImagesToHorizontalBox(0, 0, 0);
 	}
 	else
 	{
-		// Calculate the unlocked against locked points (stars) 
-		ProgressionMenuWidgetInternal->AddImagesToHorizontalBox(CurrenSaveToDiskDataRow.CurrentLevelProgression, CurrenProgressionSettingsRow.PointsToUnlock - CurrenSaveToDiskDataRow.CurrentLevelProgression, CurrenProgressionSettingsRow.PointsToUnlock); // Listen game state changes events 
+		// Presentation is precomputed per row, so only the cached state is applied
+		ProgressionMenuWidgetInternal->ApplyPresentationData(WorldSubsystem.GetDisplayedPresentationData(LocalPlayerIndex));
 	}
+}
 
-	if (AMyGameStateBase::GetCurrentGameState() == ECurrentGameState::Menu)
+// Returns the menu widget, creates it on the first call
+UPSMenuWidget& UPSHUDComponent::GetOrCreateMenuWidget()
+{
+	if (!ProgressionMenuWidgetInternal)
 	{
-		ProgressionMenuWidgetInternal->SetPadding(FMargin(0));
-
-		if (PSMenuWidgetEnabledInternal)
-		{
-			ProgressionMenuWidgetInternal->SetVisibility(ESlateVisibility::Visible);
-		}
-		else
-		{
-			ProgressionMenuWidgetInternal->AddImagesToHorizontalBox(0, 0, 0);
-		}
+		ProgressionMenuWidgetInternal = UWidgetsSubsystem::Get().CreateManageableWidgetChecked<UPSMenuWidget>(GetPSContext().GetDataAssetChecked().GetProgressionMenuWidget());
 	}
+	return *ProgressionMenuWidgetInternal;
+}
 
-	DisplayLevelUIOverlay(CurrenSaveToDiskDataRow.IsLevelLocked);
+// Returns the overlay widget, creates it on the first call
+UPSOverlayWidget& UPSHUDComponent::GetOrCreateOverlayWidget()
+{
+	if (!ProgressionMenuOverlayWidgetInternal)
+	{
+		ProgressionMenuOverlayWidgetInternal = UWidgetsSubsystem::Get().CreateManageableWidgetChecked<UPSOverlayWidget>(GetPSContext().GetDataAssetChecked().GetProgressionOverlayWidget());
+	}
+	return *ProgressionMenuOverlayWidgetInternal;
 }
 
 //Is called when local player character is ready to guarantee that they player controller is initialized for the Widget SubSystem
@@ -191,13 +286,38 @@ void UPSHUDComponent::OnLocalCharacterReady_Implementation(APlayerCharacter* Cha
 		return;
 	}
 
-	// Create widgets now as fast as possible, later we will register them in Widgets Subsystem
-	UWidgetsSubsystem& WidgetsSubsystem = UWidgetsSubsystem::Get();
-	ProgressionMenuWidgetInternal = WidgetsSubsystem.CreateManageableWidgetChecked<UPSMenuWidget>(UPSDataAsset::Get().GetProgressionMenuWidget());
-	ProgressionMenuOverlayWidgetInternal = WidgetsSubsystem.CreateManageableWidgetChecked<UPSOverlayWidget>(UPSDataAsset::Get().GetProgressionOverlayWidget());
+	// In split-screen each HUD is initialized only by the character of its own player
+	UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
+	if (WorldSubsystem.GetLocalPlayerIndex(Character) != GetPSContext().GetLocalPlayerIndex())
+	{
+		return;
+	}
+
+	if (WorldSubsystem.IsProgressionReady())
+	{
+		// The module is already initialized by the primary player, so this player joined later
+		OnInitialized();
+		return;
+	}
 
-	UPSWorldSubsystem& WorldSubsystem = UPSWorldSubsystem::Get();
-	WorldSubsystem.OnInitialize.AddUniqueDynamic(this, &ThisClass::OnInitialized);
+	if (WorldSubsystem.IsProgressionFailed())
+	{
+		// The progression is not available in this world, so there is nothing to display
+		return;
+	}
+
+	// Widgets are not created here, but on their first display, since the Widget Subsystem is ready from now
+	TPSEventChannel<FPSInitializedEvent>& InitializedEvent = WorldSubsystem.GetEventBus().Initialized;
+	if (!InitializedEvent.IsSubscribed(this))
+	{
+		InitializedEvent.Subscribe(FPSEventBus::FInitializedHandler::CreateWeakLambda(this, [this](const FPSInitializedEvent& Event)
+		{
+			if (Event.bIsSucceeded)
+			{
+				OnInitialized();
+			}
+		}));
+	}
 	WorldSubsystem.OnWorldSubSystemInitialize();
 }
 
@@ -205,18 +325,19 @@ void UPSHUDComponent::OnLocalCharacterReady_Implementation(APlayerCharacter* Cha
 // by default overlay is always displayed 
 void UPSHUDComponent::DisplayLevelUIOverlay(bool IsLevelLocked)
 {
-	if (!ensureMsgf(ProgressionMenuWidgetInternal, TEXT("ASSERT: [%i] %hs:\n'ProgressionMenuWidgetInternal' is null!"), __LINE__, __FUNCTION__))
+	if (!IsLevelLocked && !ProgressionMenuOverlayWidgetInternal)
 	{
+		// Overlay was never displayed, so there is nothing to hide
 		return;
 	}
 
-	if (USettingsWidget* SettingsWidget = UMyBlueprintFunctionLibrary::GetSettingsWidget())
+	if (USettingsWidget* SettingsWidget = GetPSContext().GetSubsystemChecked().GetSettingsWidget())
 	{
-		const bool bShouldPlayFadeAnimation = !SettingsWidget->GetCheckboxValue(UPSDataAsset::Get().GetInstantCharacterSwitchTag());
+		const bool bShouldPlayFadeAnimation = !SettingsWidget->GetCheckboxValue(GetPSContext().GetDataAssetChecked().GetInstantCharacterSwitchTag());
 		if (IsLevelLocked)
 		{
-			// Level is locked show the blocking overlay
-			ProgressionMenuOverlayWidgetInternal->SetOverlayVisibility(ESlateVisibility::Visible, bShouldPlayFadeAnimation);
+			// Level is locked show the blocking overlay, it's created on the first display
+			GetOrCreateOverlayWidget().SetOverlayVisibility(ESlateVisibility::Visible, bShouldPlayFadeAnimation);
 		}
 		else
 		{
@@ -225,3 +346,4 @@ void UPSHUDComponent::DisplayLevelUIOverlay(bool IsLevelLocked)
 		}
 	}
 }
+
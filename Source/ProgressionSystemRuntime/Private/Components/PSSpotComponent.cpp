@@ -7,6 +7,7 @@
 #include "Data/PSSaveGameData.h"
 #include "Components/MySkeletalMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
 #include "LevelActors/PlayerCharacter.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Subsystems/GlobalEventsSubsystem.h"
@@ -29,21 +30,40 @@ void UPSSpotComponent::OnInitialized_Implementation()
 	// Ensure the component's mesh is properly assigned and not null.
 	PlayerSpotOnLevelInternal = GetMeshChecked();
 
-	UPSWorldSubsystem::Get().OnCurrentRowDataChanged.AddDynamic(this, &ThisClass::OnPlayerTypeChanged);
+	GetPSContext().GetSubsystemChecked().GetEventBus().RowChanged.Subscribe(FPSEventBus::FRowChangedHandler::CreateWeakLambda(this, [this](const FPSRowChangedEvent& Event)
+	{
+		OnPlayerTypeChanged(Event.PlayerTag);
+	}));
 	// Subscribe events on player type changed and Character spawned
 	BIND_ON_LOCAL_CHARACTER_READY(this, ThisClass::OnLocalCharacterReady);
 
 	ChangeSpotVisibilityStatus();
 
 	// Save reference of this component to the world subsystem
-	UPSWorldSubsystem::Get().RegisterSpotComponent(this);
+	GetPSContext().GetSubsystemChecked().RegisterSpotComponent(this);
 }
 
 // Called when the game starts
 void UPSSpotComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	UPSWorldSubsystem::Get().OnInitialize.AddDynamic(this, &ThisClass::OnInitialized);
+
+	UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
+	if (WorldSubsystem.IsProgressionReady())
+	{
+		// The spot is streamed in after initialization, so it catches up with the current progression right away
+		OnInitialized();
+		return;
+	}
+
+	WorldSubsystem.GetEventBus().Initialized.Subscribe(FPSEventBus::FInitializedHandler::CreateWeakLambda(this, [this](const FPSInitializedEvent& Event)
+	{
+		// The spot stays unlocked if the progression is not available
+		if (Event.bIsSucceeded)
+		{
+			OnInitialized();
+		}
+	}));
 }
 
 // Clears all transient data created by this component.
@@ -57,6 +77,18 @@ void UPSSpotComponent::OnUnregister()
 		PlayerSpotOnLevelInternal = nullptr;
 	}
 
+	// Subsystem might be already deinitialized if the world is torn down
+	const UWorld* World = GetWorld();
+	if (UPSWorldSubsystem* WorldSubsystem = World ? World->GetSubsystem<UPSWorldSubsystem>() : nullptr)
+	{
+		FPSEventBus& EventBus = WorldSubsystem->GetEventBus();
+		EventBus.RowChanged.UnsubscribeAll(this);
+		EventBus.Initialized.UnsubscribeAll(this);
+
+		// The spot is streamed out or destroyed
+		WorldSubsystem->UnregisterSpotComponent(this);
+	}
+
 	Super::OnUnregister();
 }
 
@@ -84,7 +116,7 @@ void UPSSpotComponent::OnPlayerTypeChanged_Implementation(FPlayerTag PlayerTag)
 		ChangeSpotVisibilityStatus();
 
 		// Save reference of this component to the world subsystem
-		UPSWorldSubsystem::Get().SetCurrentSpotComponent(this);
+		GetPSContext().GetSubsystemChecked().SetCurrentSpotComponent(this);
 	}
 }
 
@@ -94,6 +126,8 @@ void UPSSpotComponent::OnLocalCharacterReady_Implementation(APlayerCharacter* Pl
 	if (PlayerCharacter->GetPlayerTag() == GetMeshChecked().GetPlayerTag())
 	{
 		PlayerSpotOnLevelInternal = GetMeshChecked();
+		UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
+		WorldSubsystem.GetEventBus().SpotReady.Broadcast(FPSSpotReadyEvent{this, WorldSubsystem.GetLocalPlayerIndex(PlayerCharacter)});
 		OnSpotComponentReady.Broadcast(this);
 	}
 }
@@ -104,7 +138,10 @@ void UPSSpotComponent::ChangeSpotVisibilityStatus()
 	// Locks and unlocks the spot depends on the current level progression status
 	if (PlayerSpotOnLevelInternal)
 	{
-		FPSSaveToDiskData SaveToDiskDataRow = UPSWorldSubsystem::Get().GetCurrentSaveToDiskRowByName();
-		PlayerSpotOnLevelInternal->SetActive(!SaveToDiskDataRow.IsLevelLocked);
+		// The lock state is taken from the profile of the local player who is on this spot
+		const UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
+		const int32 LocalPlayerIndex = WorldSubsystem.GetSpotLocalPlayerIndex(this);
+		PlayerSpotOnLevelInternal->SetActive(!WorldSubsystem.GetPresentationData(WorldSubsystem.GetCurrentRowName(LocalPlayerIndex), LocalPlayerIndex).bIsLevelLocked);
 	}
 }
+
@@ -0,0 +1,81 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSContext.h"
+//---
+#include "Data/PSDataAsset.h"
+#include "Data/PSWorldSubsystem.h"
+#include "Engine/World.h"
+
+// Resolves the context from the world of given object, does nothing if it's already resolved
+void FPSContext::ResolveIfNeeded(const UObject& WorldContextObject)
+{
+	if (IsValid())
+	{
+		return;
+	}
+
+	// World is taken from the object itself, so it's not counted as a global lookup
+	const UWorld* World = WorldContextObject.GetWorld();
+	UPSWorldSubsystem* Subsystem = World ? World->GetSubsystem<UPSWorldSubsystem>() : nullptr;
+	SubsystemInternal = Subsystem;
+	DataAssetInternal = Subsystem ? Subsystem->GetPSDataAsset() : nullptr;
+	LocalPlayerIndexInternal = Subsystem ? Subsystem->GetLocalPlayerIndex(&WorldContextObject) : 0;
+}
+
+// Returns true if both the subsystem and the data asset are resolved and still alive
+bool FPSContext::IsValid() const
+{
+	return SubsystemInternal.IsValid() && DataAssetInternal.IsValid();
+}
+
+// Clears resolved references, e.g. when the owner is unregistered
+void FPSContext::Reset()
+{
+	SubsystemInternal.Reset();
+	DataAssetInternal.Reset();
+	LocalPlayerIndexInternal = 0;
+}
+
+// Returns the progression subsystem of the resolved world, is checked
+UPSWorldSubsystem& FPSContext::GetSubsystemChecked() const
+{
+	UPSWorldSubsystem* Subsystem = SubsystemInternal.Get();
+	checkf(Subsystem, TEXT("ERROR: [%i] %hs:\n'Subsystem' is null, the context is not resolved!"), __LINE__, __FUNCTION__);
+	return *Subsystem;
+}
+
+// Returns the progression data asset, is checked
+const UPSDataAsset& FPSContext::GetDataAssetChecked() const
+{
+	const UPSDataAsset* DataAsset = DataAssetInternal.Get();
+	checkf(DataAsset, TEXT("ERROR: [%i] %hs:\n'DataAsset' is null, the context is not resolved!"), __LINE__, __FUNCTION__);
+	return *DataAsset;
+}
+
+// Returns the current progression row name
+FName FPSContext::GetCurrentRowName() const
+{
+	const UPSWorldSubsystem* Subsystem = SubsystemInternal.Get();
+	return Subsystem ? Subsystem->GetCurrentRowName(LocalPlayerIndexInternal) : NAME_None;
+}
+
+// Returns the settings of the current progression row
+const FPSRowData& FPSContext::GetCurrentSettingsRow() const
+{
+	const UPSWorldSubsystem* Subsystem = SubsystemInternal.Get();
+	return Subsystem ? Subsystem->GetCurrentProgressionSettingsRowByName(LocalPlayerIndexInternal) : FPSRowData::EmptyData;
+}
+
+// Returns the saved data of the current progression row
+const FPSSaveToDiskData& FPSContext::GetCurrentSaveRow() const
+{
+	const UPSWorldSubsystem* Subsystem = SubsystemInternal.Get();
+	return Subsystem && Subsystem->GetCurrentSaveGameData(LocalPlayerIndexInternal) ? Subsystem->GetCurrentSaveToDiskRowByName(LocalPlayerIndexInternal) : FPSSaveToDiskData::EmptyData;
+}
+
+// Returns the cached presentation of the current progression row
+const FPSPresentationData& FPSContext::GetCurrentPresentation() const
+{
+	const UPSWorldSubsystem* Subsystem = SubsystemInternal.Get();
+	return Subsystem ? Subsystem->GetPresentationData(Subsystem->GetCurrentRowName(LocalPlayerIndexInternal), LocalPlayerIndexInternal) : FPSPresentationData::EmptyData;
+}
@@ -3,6 +3,15 @@
 #include "Data/PSDataAsset.h"
 
 #include "Data/PSWorldSubsystem.h"
+//---
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInterface.h"
+
+#if WITH_EDITOR
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Misc/DataValidation.h"
+#endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PSDataAsset)
 
@@ -12,3 +21,217 @@ const UPSDataAsset& UPSDataAsset::Get()
 	ensureMsgf(DataAsset, TEXT("ASSERT: [%i] %hs:\n'DataAsset' is null!"), __LINE__, __FUNCTION__);
 	return *DataAsset;
 }
+
+// Returns the progression data asset of the given world or crash if can not be obtained
+const UPSDataAsset& UPSDataAsset::Get(const UObject& WorldContextObject)
+{
+	const UPSDataAsset* DataAsset = UPSWorldSubsystem::Get(WorldContextObject).GetPSDataAsset();
+	ensureMsgf(DataAsset, TEXT("ASSERT: [%i] %hs:\n'DataAsset' is null!"), __LINE__, __FUNCTION__);
+	return *DataAsset;
+}
+
+// Returns the formation of stars above the character on the level, is the Line formation if the row has no formation set
+const FPSStarsFormationData& UPSDataAsset::GetStarsFormation(FName RowName) const
+{
+	const FPSStarsFormationData* FormationData = StarsFormationsInternal.Find(RowName);
+	return FormationData ? *FormationData : FPSStarsFormationData::EmptyData;
+}
+
+// Returns the amount of stars to display for given points to unlock, is capped by the maximum amount of stars to display
+int32 UPSDataAsset::GetStarsToDisplayNum(float PointsToUnlock) const
+{
+	const int32 StarsNum = FMath::CeilToInt(FMath::Max(PointsToUnlock, 0.f));
+	return MaxStarsToDisplayInternal > 0 ? FMath::Min(StarsNum, MaxStarsToDisplayInternal) : StarsNum;
+}
+
+// Returns the scale to convert progression points into displayed stars, is 1 when the level is not compacted
+float UPSDataAsset::GetStarsDisplayScale(float PointsToUnlock) const
+{
+	const int32 StarsNum = GetStarsToDisplayNum(PointsToUnlock);
+	return StarsNum > 0 && PointsToUnlock > StarsNum ? StarsNum / PointsToUnlock : 1.f;
+}
+
+// Points star brushes to the standalone icons if the atlas was never built, moves the star material of old assets
+void UPSDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	// Locked, unlocked and dynamic materials were replaced by the single star material, the dynamic one already supported partial fill
+	UMaterialInterface* DeprecatedStarMaterial = DynamicProgressionMaterialInternal_DEPRECATED ? DynamicProgressionMaterialInternal_DEPRECATED : UnlockedProgressionMaterialInternal_DEPRECATED;
+	if (DeprecatedStarMaterial && !StarProgressionMaterialInternal)
+	{
+		StarProgressionMaterialInternal = DeprecatedStarMaterial;
+		UE_LOG(LogProgressionSystem, Warning, TEXT("%s: 'Star Progression Material' is migrated from '%s', it has to read fill and lock values from custom primitive data, resave the asset"), *GetPathName(), *DeprecatedStarMaterial->GetPathName());
+	}
+	DynamicProgressionMaterialInternal_DEPRECATED = nullptr;
+	UnlockedProgressionMaterialInternal_DEPRECATED = nullptr;
+
+#if WITH_EDITOR
+	// Old star materials read the fill from the scalar parameter that is never set anymore, so stars would be always empty
+	if (StarProgressionMaterialInternal && !DoesStarMaterialReadPrimitiveData())
+	{
+		UE_LOG(LogProgressionSystem, Warning, TEXT("%s: '%s' doesn't read custom primitive data %i (fill) and %i (lock), enable 'Use Custom Primitive Data' on its scalar parameters"), *GetPathName(), *StarProgressionMaterialInternal->GetPathName(), StarFillPrimitiveDataIndexInternal, StarLockPrimitiveDataIndexInternal);
+	}
+#endif
+
+	// Brushes are built only in the editor, so the asset saved before the atlas existed has empty brushes in cooked builds too
+	if (!StarIconsAtlasInternal
+		|| !LockedStarBrushInternal.GetResourceObject()
+		|| !UnlockedStarBrushInternal.GetResourceObject())
+	{
+		ApplyStandaloneStarBrushes();
+	}
+}
+
+// Points star brushes to the standalone icons, stars still work but are not batched
+void UPSDataAsset::ApplyStandaloneStarBrushes()
+{
+	UTexture2D* Icons[] = {LockedProgressionIconInternal, UnlockedProgressionIconInternal};
+	FSlateBrush* Brushes[] = {&LockedStarBrushInternal, &UnlockedStarBrushInternal};
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Icons); ++Index)
+	{
+		*Brushes[Index] = FSlateBrush();
+		Brushes[Index]->SetResourceObject(Icons[Index]);
+		if (Icons[Index])
+		{
+			Brushes[Index]->SetImageSize(FVector2D(Icons[Index]->GetSizeX(), Icons[Index]->GetSizeY()));
+		}
+	}
+}
+
+#if WITH_EDITOR
+// Packs the locked and unlocked icons into the single star icons atlas and updates star brushes to its UV regions
+void UPSDataAsset::RebuildStarIconsAtlas()
+{
+	UTexture2D* Icons[] = {LockedProgressionIconInternal, UnlockedProgressionIconInternal};
+	FSlateBrush* Brushes[] = {&LockedStarBrushInternal, &UnlockedStarBrushInternal};
+	constexpr int32 IconsNum = UE_ARRAY_COUNT(Icons);
+
+	// Icons are packed in a single row, so the atlas is as wide as all icons together
+	int32 AtlasSizeX = 0;
+	int32 AtlasSizeY = 0;
+	bool bCanBuildAtlas = true;
+	for (const UTexture2D* Icon : Icons)
+	{
+		if (!Icon
+			|| !Icon->Source.IsValid()
+			|| Icon->Source.GetFormat() != TSF_BGRA8)
+		{
+			bCanBuildAtlas = false;
+			break;
+		}
+
+		AtlasSizeX += Icon->Source.GetSizeX();
+		AtlasSizeY = FMath::Max(AtlasSizeY, Icon->Source.GetSizeY());
+	}
+
+	if (!bCanBuildAtlas)
+	{
+		// Fallback to standalone icons, stars still work but are not batched
+		UE_LOG(LogProgressionSystem, Warning, TEXT("%s: Star icons atlas is not built, both icons have to be set with BGRA8 source"), *GetName());
+		StarIconsAtlasInternal = nullptr;
+		ApplyStandaloneStarBrushes();
+		MarkPackageDirty();
+		return;
+	}
+
+	constexpr int32 BytesPerPixel = 4;
+	TArray64<uint8> AtlasData;
+	AtlasData.SetNumZeroed(static_cast<int64>(AtlasSizeX) * AtlasSizeY * BytesPerPixel);
+
+	if (!StarIconsAtlasInternal)
+	{
+		StarIconsAtlasInternal = NewObject<UTexture2D>(this, TEXT("StarIconsAtlas"), RF_Public);
+	}
+
+	int32 OffsetX = 0;
+	for (int32 Index = 0; Index < IconsNum; ++Index)
+	{
+		UTexture2D* Icon = Icons[Index];
+		const int32 IconSizeX = Icon->Source.GetSizeX();
+		const int32 IconSizeY = Icon->Source.GetSizeY();
+
+		TArray64<uint8> IconData;
+		if (Icon->Source.GetMipData(IconData, /*BlockIndex*/0, /*LayerIndex*/0, /*MipIndex*/0))
+		{
+			for (int32 Row = 0; Row < IconSizeY; ++Row)
+			{
+				const int64 AtlasOffset = (static_cast<int64>(Row) * AtlasSizeX + OffsetX) * BytesPerPixel;
+				const int64 IconOffset = static_cast<int64>(Row) * IconSizeX * BytesPerPixel;
+				FMemory::Memcpy(&AtlasData[AtlasOffset], &IconData[IconOffset], IconSizeX * BytesPerPixel);
+			}
+		}
+
+		FSlateBrush& Brush = *Brushes[Index];
+		Brush = FSlateBrush();
+		Brush.SetResourceObject(StarIconsAtlasInternal);
+		Brush.SetImageSize(FVector2D(IconSizeX, IconSizeY));
+		Brush.SetUVRegion(FBox2f(
+			FVector2f(static_cast<float>(OffsetX) / AtlasSizeX, 0.f),
+			FVector2f(static_cast<float>(OffsetX + IconSizeX) / AtlasSizeX, static_cast<float>(IconSizeY) / AtlasSizeY)));
+
+		OffsetX += IconSizeX;
+	}
+
+	StarIconsAtlasInternal->PreEditChange(nullptr);
+	StarIconsAtlasInternal->Source.Init(AtlasSizeX, AtlasSizeY, /*NumSlices*/1, /*NumMips*/1, TSF_BGRA8, AtlasData.GetData());
+	StarIconsAtlasInternal->SRGB = Icons[0]->SRGB;
+	StarIconsAtlasInternal->CompressionSettings = TC_EditorIcon;
+	StarIconsAtlasInternal->LODGroup = TEXTUREGROUP_UI;
+	StarIconsAtlasInternal->MipGenSettings = TMGS_NoMipmaps;
+	StarIconsAtlasInternal->PostEditChange();
+
+	MarkPackageDirty();
+}
+
+// Rebuilds the star icons atlas when any icon is changed
+void UPSDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, LockedProgressionIconInternal)
+		|| PropertyName == GET_MEMBER_NAME_CHECKED(ThisClass, UnlockedProgressionIconInternal))
+	{
+		RebuildStarIconsAtlas();
+	}
+}
+
+// Fails if the star material doesn't read fill and lock values from custom primitive data
+EDataValidationResult UPSDataAsset::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	if (StarProgressionMaterialInternal && !DoesStarMaterialReadPrimitiveData())
+	{
+		Context.AddError(FText::Format(NSLOCTEXT("ProgressionSystem", "StarMaterialPrimitiveData", "'{0}' has to read the star fill from custom primitive data {1} and the lock from {2}"),
+		                               FText::FromString(StarProgressionMaterialInternal->GetPathName()), StarFillPrimitiveDataIndexInternal, StarLockPrimitiveDataIndexInternal));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	return Result;
+}
+
+// Returns true if the star material has scalar parameters that read both fill and lock custom primitive data indices
+bool UPSDataAsset::DoesStarMaterialReadPrimitiveData() const
+{
+	const UMaterial* StarMaterial = StarProgressionMaterialInternal ? StarProgressionMaterialInternal->GetMaterial() : nullptr;
+	if (!StarMaterial)
+	{
+		return false;
+	}
+
+	bool bReadsFill = false;
+	bool bReadsLock = false;
+	for (const UMaterialExpression* Expression : StarMaterial->GetExpressions())
+	{
+		const UMaterialExpressionScalarParameter* ScalarParameter = Cast<UMaterialExpressionScalarParameter>(Expression);
+		if (ScalarParameter && ScalarParameter->bUseCustomPrimitiveData)
+		{
+			bReadsFill |= ScalarParameter->PrimitiveDataIndex == StarFillPrimitiveDataIndexInternal;
+			bReadsLock |= ScalarParameter->PrimitiveDataIndex == StarLockPrimitiveDataIndexInternal;
+		}
+	}
+	return bReadsFill && bReadsLock;
+}
+#endif
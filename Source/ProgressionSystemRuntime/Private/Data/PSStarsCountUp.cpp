@@ -0,0 +1,99 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSStarsCountUp.h"
+
+// Starts the animation of the local player from given progression, the previous animation of this player is replaced
+void FPSStarsCountUp::Play(int32 LocalPlayerIndex, float FromPoints, float Duration)
+{
+	if (LocalPlayerIndex < 0 || Duration <= 0.f)
+	{
+		Stop(LocalPlayerIndex);
+		return;
+	}
+
+	if (!AnimationsInternal.IsValidIndex(LocalPlayerIndex))
+	{
+		AnimationsInternal.SetNum(LocalPlayerIndex + 1);
+	}
+
+	FPSCountUpAnimation& Animation = AnimationsInternal[LocalPlayerIndex];
+	Animation.bIsPlaying = true;
+	Animation.FromPoints = FromPoints;
+	Animation.ElapsedTime = 0.f;
+	Animation.Duration = Duration;
+
+	if (!TickerHandleInternal.IsValid())
+	{
+		TickerHandleInternal = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FPSStarsCountUp::Tick));
+	}
+}
+
+// Stops the animation of the local player, its stars display the saved progression
+void FPSStarsCountUp::Stop(int32 LocalPlayerIndex)
+{
+	if (AnimationsInternal.IsValidIndex(LocalPlayerIndex))
+	{
+		// The clock unregisters itself on the next tick if nothing else is playing
+		AnimationsInternal[LocalPlayerIndex].bIsPlaying = false;
+	}
+}
+
+// Stops animations of all local players and unregisters the clock
+void FPSStarsCountUp::StopAll()
+{
+	AnimationsInternal.Reset();
+
+	if (TickerHandleInternal.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandleInternal);
+		TickerHandleInternal.Reset();
+	}
+}
+
+// Returns true if the animation of the local player is playing
+bool FPSStarsCountUp::IsPlaying(int32 LocalPlayerIndex) const
+{
+	return AnimationsInternal.IsValidIndex(LocalPlayerIndex) && AnimationsInternal[LocalPlayerIndex].bIsPlaying;
+}
+
+// Returns the level progression displayed by stars of the local player, is behind the saved one while the animation is playing
+float FPSStarsCountUp::GetDisplayedProgression(int32 LocalPlayerIndex, float SavedProgression) const
+{
+	if (!IsPlaying(LocalPlayerIndex))
+	{
+		return SavedProgression;
+	}
+
+	const FPSCountUpAnimation& Animation = AnimationsInternal[LocalPlayerIndex];
+	const float Alpha = Animation.Duration > 0.f ? FMath::Clamp(Animation.ElapsedTime / Animation.Duration, 0.f, 1.f) : 1.f;
+	return FMath::Lerp(Animation.FromPoints, SavedProgression, Alpha);
+}
+
+// Advances animations of all local players, returns false once all of them are complete to unregister the clock
+bool FPSStarsCountUp::Tick(float DeltaTime)
+{
+	bool bIsAnyPlaying = false;
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < AnimationsInternal.Num(); ++LocalPlayerIndex)
+	{
+		FPSCountUpAnimation& Animation = AnimationsInternal[LocalPlayerIndex];
+		if (!Animation.bIsPlaying)
+		{
+			continue;
+		}
+
+		// The last frame is displayed by the saved progression, so the completed animation is stopped before the update
+		Animation.ElapsedTime += DeltaTime;
+		Animation.bIsPlaying = Animation.ElapsedTime < Animation.Duration;
+		bIsAnyPlaying |= Animation.bIsPlaying;
+
+		OnUpdated.ExecuteIfBound(LocalPlayerIndex);
+	}
+
+	if (!bIsAnyPlaying)
+	{
+		// Ticker is removed by returning false, so the completed animation costs nothing
+		TickerHandleInternal.Reset();
+	}
+
+	return bIsAnyPlaying;
+}
@@ -0,0 +1,68 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSStarsLayout.h"
+//---
+#include "Data/PSTypes.h"
+
+// Returns the hash of the row settings which affect the layout, is used to invalidate the cached layout
+uint32 FPSStarsLayout::GetLayoutHash(const FPSRowData& RowData, const FPSStarsFormationData& FormationData, int32 StarsNum)
+{
+	const FTransform& BaseTransform = RowData.StarActorTransform;
+	uint32 Hash = GetTypeHash(StarsNum);
+	Hash = HashCombine(Hash, GetTypeHash(BaseTransform.GetLocation()));
+	Hash = HashCombine(Hash, GetTypeHash(BaseTransform.GetRotation().Euler()));
+	Hash = HashCombine(Hash, GetTypeHash(BaseTransform.GetScale3D()));
+	Hash = HashCombine(Hash, GetTypeHash(RowData.OffsetBetweenStarActors));
+	Hash = HashCombine(Hash, GetTypeHash(FormationData));
+	return Hash;
+}
+
+// Computes world transforms of all stars in the row according to its formation
+void FPSStarsLayout::ComputeLayout(const FPSRowData& RowData, const FPSStarsFormationData& FormationData, int32 StarsNum, FPSStarsLayoutData& OutLayoutData)
+{
+	OutLayoutData.SettingsHash = GetLayoutHash(RowData, FormationData, StarsNum);
+	OutLayoutData.StarTransforms.Reset(StarsNum);
+
+	const FTransform& BaseTransform = RowData.StarActorTransform;
+	for (int32 StarIndex = 0; StarIndex < StarsNum; ++StarIndex)
+	{
+		FTransform& StarTransform = OutLayoutData.StarTransforms.Add_GetRef(BaseTransform);
+		StarTransform.AddToTranslation(GetStarOffset(RowData, FormationData, StarIndex, StarsNum));
+	}
+}
+
+// Returns the offset of the star from the base transform location by its index
+FVector FPSStarsLayout::GetStarOffset(const FPSRowData& RowData, const FPSStarsFormationData& FormationData, int32 StarIndex, int32 StarsNum)
+{
+	const FVector& OffsetBetweenStars = RowData.OffsetBetweenStarActors;
+
+	// Arc and Ring are built in the plane of the offset direction, so the row keeps its orientation on the level
+	const FVector SideDirection = OffsetBetweenStars.IsNearlyZero() ? FVector::RightVector : OffsetBetweenStars.GetSafeNormal();
+	const FVector ForwardDirection = FVector::CrossProduct(SideDirection, FVector::UpVector).GetSafeNormal();
+
+	switch (FormationData.Formation)
+	{
+	case EPSStarsFormation::Arc:
+	{
+		// Spread stars evenly from -ArcAngle/2 to ArcAngle/2, the middle star is placed on the base location
+		const float AngleStep = StarsNum > 1 ? FormationData.ArcAngle / (StarsNum - 1) : 0.f;
+		const float AngleRad = FMath::DegreesToRadians(-FormationData.ArcAngle * 0.5f + AngleStep * StarIndex);
+		return SideDirection * FormationData.Radius * FMath::Sin(AngleRad)
+			+ FVector::UpVector * FormationData.Radius * (FMath::Cos(AngleRad) - 1.f);
+	}
+	case EPSStarsFormation::Ring:
+	{
+		const float AngleRad = StarsNum > 0 ? UE_TWO_PI * StarIndex / StarsNum : 0.f;
+		return SideDirection * FormationData.Radius * FMath::Cos(AngleRad)
+			+ ForwardDirection * FormationData.Radius * FMath::Sin(AngleRad);
+	}
+	case EPSStarsFormation::Grid:
+	{
+		const int32 Columns = FMath::Max(FormationData.GridColumns, 1);
+		return OffsetBetweenStars * (StarIndex % Columns) + FormationData.GridRowOffset * (StarIndex / Columns);
+	}
+	case EPSStarsFormation::Line:
+	default:
+		return OffsetBetweenStars * StarIndex;
+	}
+}
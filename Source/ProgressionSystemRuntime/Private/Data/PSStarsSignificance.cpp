@@ -0,0 +1,103 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Data/PSStarsSignificance.h"
+//---
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "LevelActors/PSStarActor.h"
+#include "TimerManager.h"
+
+// Returns the significance of the star: 1 at the closest camera, 0 if it's too far from all cameras, -1 if it's not rendered
+float FPSStarsSignificance::GetStarSignificance(const FVector& StarLocation, bool bIsRendered, TConstArrayView<FVector> CameraLocations, float SignificanceDistance)
+{
+	if (!bIsRendered)
+	{
+		return -1.f;
+	}
+
+	// The star is as significant as it is for the closest camera
+	const float SignificanceDistanceSq = FMath::Square(FMath::Max(SignificanceDistance, 1.f));
+	float Significance = 0.f;
+	for (const FVector& CameraLocation : CameraLocations)
+	{
+		const float DistanceSq = FVector::DistSquared(CameraLocation, StarLocation);
+		if (DistanceSq < SignificanceDistanceSq)
+		{
+			Significance = FMath::Max(Significance, 1.f - DistanceSq / SignificanceDistanceSq);
+		}
+	}
+	return Significance;
+}
+
+// Starts evaluating the significance periodically, does nothing if it's already started or the interval is 0
+void FPSStarsSignificance::Start(UWorld& World, float UpdateInterval, const FTimerDelegate& UpdateDelegate)
+{
+	FTimerManager& TimerManager = World.GetTimerManager();
+	if (UpdateInterval > 0.f && !TimerManager.IsTimerActive(TimerHandleInternal))
+	{
+		TimerManager.SetTimer(TimerHandleInternal, UpdateDelegate, UpdateInterval, true);
+	}
+}
+
+// Stops evaluating the significance, star actors keep their last throttling
+void FPSStarsSignificance::Stop(const UWorld* World)
+{
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(TimerHandleInternal);
+	}
+	TimerHandleInternal.Invalidate();
+}
+
+// Scores each star by cameras of all local players and throttles animations of low significant stars
+bool FPSStarsSignificance::Update(const UWorld& World, TConstArrayView<TObjectPtr<APSStarActor>> StarActors, const FPSStarsSignificanceSettings& Settings)
+{
+	// Each split-screen player has its own camera
+	CameraLocationsInternal.Reset();
+	for (FConstPlayerControllerIterator It = World.GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+		{
+			CameraLocationsInternal.Emplace(PlayerController->PlayerCameraManager->GetCameraLocation());
+		}
+	}
+
+	if (StarActors.IsEmpty() || CameraLocationsInternal.IsEmpty())
+	{
+		return false;
+	}
+
+	// Score stars: not rendered stars are the least significant, rendered ones are more significant when closer to any camera
+	constexpr float RecentlyRenderedTolerance = 0.2f;
+	ScoredStarsInternal.Reset(StarActors.Num());
+	for (APSStarActor* StarActor : StarActors)
+	{
+		if (IsValid(StarActor))
+		{
+			const float Significance = GetStarSignificance(StarActor->GetActorLocation(), StarActor->WasRecentlyRendered(RecentlyRenderedTolerance), CameraLocationsInternal, Settings.SignificanceDistance);
+			ScoredStarsInternal.Emplace(Significance, StarActor);
+		}
+	}
+	ScoredStarsInternal.Sort([](const TPair<float, APSStarActor*>& A, const TPair<float, APSStarActor*>& B) { return A.Key > B.Key; });
+
+	// Apply budget: the most significant stars are animated at full rate, the rest are throttled or frozen
+	for (int32 Index = 0; Index < ScoredStarsInternal.Num(); ++Index)
+	{
+		const float Significance = ScoredStarsInternal[Index].Key;
+		APSStarActor* StarActor = ScoredStarsInternal[Index].Value;
+		if (Significance > 0.f && Index < Settings.MaxSignificantStars)
+		{
+			StarActor->SetAnimationThrottling(0.f, false);
+		}
+		else
+		{
+			const bool bShouldFreeze = Significance < 0.f && Settings.bFreezeNotRendered;
+			StarActor->SetAnimationThrottling(Settings.ReducedTickInterval, bShouldFreeze);
+		}
+	}
+	ScoredStarsInternal.Reset();
+
+	return true;
+}
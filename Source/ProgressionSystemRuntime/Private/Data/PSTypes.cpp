@@ -3,5 +3,27 @@
 #include "Data/PSTypes.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PSTypes)
-const FPSRowData FPSRowData::EmptyData = FPSRowData{};
-const FPSSaveToDiskData FPSSaveToDiskData::EmptyData = FPSSaveToDiskData{};
\ No newline at end of file
+
+DEFINE_STAT(STAT_PSStarActorsSpawned);
+DEFINE_STAT(STAT_PSStarActorsReused);
+DEFINE_STAT(STAT_PSStarWidgetsSpawned);
+DEFINE_STAT(STAT_PSStarWidgetsReused);
+DEFINE_STAT(STAT_PSUpdatesRequested);
+DEFINE_STAT(STAT_PSUpdatesCoalesced);
+DEFINE_STAT(STAT_PSUpdatesFlushed);
+DEFINE_STAT(STAT_PSGlobalLookups);
+
+const FPSPresentationData FPSPresentationData::EmptyData = FPSPresentationData{};
+const FPSLocalPlayerData FPSLocalPlayerData::EmptyData = FPSLocalPlayerData{};
+const FPSStarsFormationData FPSStarsFormationData::EmptyData = FPSStarsFormationData{};
+
+// Creates a hash value from the formation settings
+uint32 GetTypeHash(const FPSStarsFormationData& FormationData)
+{
+	uint32 Hash = GetTypeHash(FormationData.Formation);
+	Hash = HashCombine(Hash, GetTypeHash(FormationData.Radius));
+	Hash = HashCombine(Hash, GetTypeHash(FormationData.ArcAngle));
+	Hash = HashCombine(Hash, GetTypeHash(FormationData.GridColumns));
+	Hash = HashCombine(Hash, GetTypeHash(FormationData.GridRowOffset));
+	return Hash;
+}
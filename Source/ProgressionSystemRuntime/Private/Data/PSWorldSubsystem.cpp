@@ -5,23 +5,29 @@
 #include "PoolManagerSubsystem.h"
 #include "Components/MySkeletalMeshComponent.h"
 #include "Components/PSHUDComponent.h"
+#include "Components/PSReplicationComponent.h"
 #include "Components/PSSpotComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Data/PSDataAsset.h"
+#include "Data/PSGameInstanceSubsystem.h"
+#include "Data/PSReplicationSubsystem.h"
 #include "Data/PSSaveGameData.h"
+#include "Data/PSStarsLayout.h"
 #include "Kismet/GameplayStatics.h"
 #include "LevelActors/PlayerCharacter.h"
-#include "MyDataTable/MyDataTable.h"
 #include "MyUtilsLibraries/UtilsLibrary.h"
+#include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
+#include "Blueprint/UserWidget.h"
+#include "TimerManager.h"
 #include "GameFramework/MyGameStateBase.h"
 #include "LevelActors/PSStarActor.h"
-#include "Materials/MaterialInstanceDynamic.h"
-#include "MyUtilsLibraries/GameplayUtilsLibrary.h"
 #include "Subsystems/GameDifficultySubsystem.h"
 #include "Subsystems/GlobalEventsSubsystem.h"
-#include "Materials/MaterialInstanceDynamic.h"
+#include "UI/SettingsWidget.h"
 #include "UtilityLibraries/MyBlueprintFunctionLibrary.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PSWorldSubsystem)
@@ -29,6 +35,7 @@
 // Returns this Subsystem, is checked and will crash if it can't be obtained
 UPSWorldSubsystem& UPSWorldSubsystem::Get()
 {
+	INC_DWORD_STAT(STAT_PSGlobalLookups);
 	const UWorld* World = UUtilsLibrary::GetPlayWorld();
 	checkf(World, TEXT("%s: 'World' is null"), *FString(__FUNCTION__));
 	UPSWorldSubsystem* ThisSubsystem = World->GetSubsystem<ThisClass>();
@@ -39,6 +46,7 @@ UPSWorldSubsystem& UPSWorldSubsystem::Get()
 // Returns this Subsystem, is checked and will crash if it can't be obtained
 UPSWorldSubsystem& UPSWorldSubsystem::Get(const UObject& WorldContextObject)
 {
+	INC_DWORD_STAT(STAT_PSGlobalLookups);
 	const UWorld* World = GEngine->GetWorldFromContextObjectChecked(&WorldContextObject);
 	checkf(World, TEXT("%s: 'World' is null"), *FString(__FUNCTION__));
 	UPSWorldSubsystem* ThisSubsystem = World->GetSubsystem<ThisClass>();
@@ -47,19 +55,90 @@ UPSWorldSubsystem& UPSWorldSubsystem::Get(const UObject& WorldContextObject)
 }
 
 // Set current row of progression system by tag
-void UPSWorldSubsystem::SetCurrentRowByTag(FPlayerTag NewRowPlayerTag)
+void UPSWorldSubsystem::SetCurrentRowByTag(FPlayerTag NewRowPlayerTag, int32 LocalPlayerIndex)
 {
-	for (const TTuple<FName, FPSRowData>& KeyValue : ProgressionSettingsDataInternal)
+	if (const FName* RowName = RowNamesByPlayerTagInternal.Find(NewRowPlayerTag))
 	{
-		const FPSRowData& RowData = KeyValue.Value;
+		// Count-up is played only for the row that earned points
+		StarsCountUpInternal.Stop(LocalPlayerIndex);
+		FPSLocalPlayerData& LocalPlayerData = GetOrAddLocalPlayerData(LocalPlayerIndex);
+		LocalPlayerData.CurrentRowName = *RowName;
+		PublishProgressionSnapshot(/*bIsRowsChanged*/false);
+		EventBusInternal.RowChanged.Broadcast(FPSRowChangedEvent{*RowName, NewRowPlayerTag, LocalPlayerIndex});
+	}
+}
+
+// Returns the progression of the local player, is empty if the player is not tracked
+const FPSLocalPlayerData& UPSWorldSubsystem::GetLocalPlayerData(int32 LocalPlayerIndex) const
+{
+	return LocalPlayersInternal.IsValidIndex(LocalPlayerIndex) ? LocalPlayersInternal[LocalPlayerIndex] : FPSLocalPlayerData::EmptyData;
+}
+
+// Returns the progression of the local player, adds it if the player is not tracked yet
+FPSLocalPlayerData& UPSWorldSubsystem::GetOrAddLocalPlayerData(int32 LocalPlayerIndex)
+{
+	checkf(LocalPlayerIndex >= 0, TEXT("ERROR: [%i] %hs:\n'LocalPlayerIndex' is negative!"), __LINE__, __FUNCTION__);
+	if (!LocalPlayersInternal.IsValidIndex(LocalPlayerIndex))
+	{
+		LocalPlayersInternal.SetNum(LocalPlayerIndex + 1);
+	}
+	return LocalPlayersInternal[LocalPlayerIndex];
+}
+
+// Returns the index of the local player that owns given object (widget, component, pawn or controller), 0 if it's not owned by any local player
+int32 UPSWorldSubsystem::GetLocalPlayerIndex(const UObject* Object) const
+{
+	// Find the player controller by the ownership chain of the object
+	const APlayerController* PlayerController = nullptr;
+	const AActor* Actor = nullptr;
+	if (const UUserWidget* Widget = Cast<UUserWidget>(Object))
+	{
+		PlayerController = Widget->GetOwningPlayer();
+	}
+	else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		Actor = Component->GetOwner();
+	}
+	else
+	{
+		Actor = Cast<AActor>(Object);
+	}
+
+	for (; Actor && !PlayerController; Actor = Actor->GetOwner())
+	{
+		PlayerController = Cast<APlayerController>(Actor);
+		if (const APawn* Pawn = Cast<APawn>(Actor))
+		{
+			PlayerController = Cast<APlayerController>(Pawn->GetController());
+		}
+	}
+
+	const UWorld* World = GetWorld();
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	if (!GameInstance || !LocalPlayer)
+	{
+		return 0;
+	}
 
-		if (RowData.Character == NewRowPlayerTag)
+	for (int32 Index = 0; Index < GameInstance->GetNumLocalPlayers(); ++Index)
+	{
+		if (GameInstance->GetLocalPlayerByIndex(Index) == LocalPlayer)
 		{
-			CurrentRowNameInternal = KeyValue.Key;
-			OnCurrentRowDataChanged.Broadcast(NewRowPlayerTag);
-			return; // Exit immediately after finding the match
+			return Index;
 		}
 	}
+	return 0;
+}
+
+// Returns the character possessed by the local player, is null if the player has no character
+APlayerCharacter* UPSWorldSubsystem::GetLocalPlayerCharacter(int32 LocalPlayerIndex) const
+{
+	const UWorld* World = GetWorld();
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	const ULocalPlayer* LocalPlayer = GameInstance ? GameInstance->GetLocalPlayerByIndex(LocalPlayerIndex) : nullptr;
+	const APlayerController* PlayerController = LocalPlayer ? LocalPlayer->GetPlayerController(World) : nullptr;
+	return PlayerController ? Cast<APlayerCharacter>(PlayerController->GetPawn()) : nullptr;
 }
 
 // Returns the data asset that contains all the assets of Progression System game feature
@@ -68,30 +147,60 @@ const UPSDataAsset* UPSWorldSubsystem::GetPSDataAsset() const
 	return UMyPrimaryDataAsset::GetOrLoadOnce(PSDataAssetInternal);
 }
 
+// Returns the data asset of this world's progression, is checked
+const UPSDataAsset& UPSWorldSubsystem::GetPSDataAssetChecked() const
+{
+	const UPSDataAsset* PSDataAsset = GetPSDataAsset();
+	checkf(PSDataAsset, TEXT("ERROR: [%i] %hs:\n'PSDataAsset' is null!"), __LINE__, __FUNCTION__);
+	return *PSDataAsset;
+}
+
+// Returns the pool manager of this world, is checked
+UPoolManagerSubsystem& UPSWorldSubsystem::GetPoolManagerChecked() const
+{
+	const UWorld* World = GetWorld();
+	UPoolManagerSubsystem* PoolManager = World ? World->GetSubsystem<UPoolManagerSubsystem>() : nullptr;
+	checkf(PoolManager, TEXT("ERROR: [%i] %hs:\n'PoolManager' is null!"), __LINE__, __FUNCTION__);
+	return *PoolManager;
+}
+
+// Returns the settings widget, is found once and kept, is null if there are no settings in this game
+USettingsWidget* UPSWorldSubsystem::GetSettingsWidget() const
+{
+	if (!SettingsWidgetInternal.IsValid())
+	{
+		INC_DWORD_STAT(STAT_PSGlobalLookups);
+		SettingsWidgetInternal = UMyBlueprintFunctionLibrary::GetSettingsWidget();
+	}
+	return SettingsWidgetInternal.Get();
+}
+
 //  Returns a current save to disk row name
-FName UPSWorldSubsystem::GetFirstSaveToDiskRowName() const
+FName UPSWorldSubsystem::GetFirstSaveToDiskRowName(int32 LocalPlayerIndex) const
 {
-	if (!ensureMsgf(SaveGameDataInternal, TEXT("ASSERT: [%i] %s:\n'SaveGameDataInternal' is empty!"), __LINE__, *FString(__FUNCTION__)))
+	const UPSSaveGameData* SaveGameData = GetCurrentSaveGameData(LocalPlayerIndex);
+	if (!ensureMsgf(SaveGameData, TEXT("ASSERT: [%i] %s:\n'SaveGameData' is empty!"), __LINE__, *FString(__FUNCTION__)))
 	{
 		return NAME_None;
 	}
-	return SaveGameDataInternal->GetSavedProgressionRowByIndex(0);
+	return SaveGameData->GetSavedProgressionRowByIndex(0);
 }
 
 //  Returns a current save to disk row by name
-const FPSSaveToDiskData& UPSWorldSubsystem::GetCurrentSaveToDiskRowByName() const
+const FPSSaveToDiskData& UPSWorldSubsystem::GetCurrentSaveToDiskRowByName(int32 LocalPlayerIndex) const
 {
-	if (!ensureMsgf(SaveGameDataInternal, TEXT("ASSERT: [%i] %s:\n'SaveGameDataInternal' is empty!"), __LINE__, *FString(__FUNCTION__)))
+	const FPSLocalPlayerData& LocalPlayerData = GetLocalPlayerData(LocalPlayerIndex);
+	if (!ensureMsgf(LocalPlayerData.SaveGameData, TEXT("ASSERT: [%i] %s:\n'SaveGameData' is empty!"), __LINE__, *FString(__FUNCTION__)))
 	{
 		return FPSSaveToDiskData::EmptyData;
 	}
-	return SaveGameDataInternal->GetSaveToDiskDataByName(CurrentRowNameInternal);
+	return LocalPlayerData.SaveGameData->GetSaveToDiskDataByName(LocalPlayerData.CurrentRowName);
 }
 
 // Returns a current progression row settings data row by name
-const FPSRowData& UPSWorldSubsystem::GetCurrentProgressionSettingsRowByName() const
+const FPSRowData& UPSWorldSubsystem::GetCurrentProgressionSettingsRowByName(int32 LocalPlayerIndex) const
 {
-	if (const FPSRowData* FoundRow = ProgressionSettingsDataInternal.Find(CurrentRowNameInternal))
+	if (const FPSRowData* FoundRow = GetProgressionSettingsData().Find(GetCurrentRowName(LocalPlayerIndex)))
 	{
 		return *FoundRow;
 	}
@@ -99,6 +208,91 @@ const FPSRowData& UPSWorldSubsystem::GetCurrentProgressionSettingsRowByName() co
 	return FPSRowData::EmptyData;
 }
 
+// Returns settings of all progression rows, are owned by the game instance subsystem and loaded from the data table once per game instance
+const TMap<FName, FPSRowData>& UPSWorldSubsystem::GetProgressionSettingsData() const
+{
+	UPSGameInstanceSubsystem* GameInstanceSubsystem = GetGameInstanceSubsystem();
+	if (!GameInstanceSubsystem)
+	{
+		// Editor preview worlds have no game instance, they have no progression
+		static const TMap<FName, FPSRowData> EmptySettings;
+		return EmptySettings;
+	}
+
+	// Is called on per-frame paths, so the data table is resolved only until settings are copied
+	const TMap<FName, FPSRowData>& ProgressionSettings = GameInstanceSubsystem->GetProgressionSettings();
+	if (!ProgressionSettings.IsEmpty())
+	{
+		return ProgressionSettings;
+	}
+
+	const UPSDataAsset* PSDataAsset = GetPSDataAsset();
+	return PSDataAsset ? GameInstanceSubsystem->GetOrLoadProgressionSettings(PSDataAsset->GetProgressionDataTable()) : ProgressionSettings;
+}
+
+// Returns the subsystem that keeps settings and save profiles between worlds, is null if this world has no game instance
+UPSGameInstanceSubsystem* UPSWorldSubsystem::GetGameInstanceSubsystem() const
+{
+	if (!GameInstanceSubsystemInternal.IsValid())
+	{
+		GameInstanceSubsystemInternal = UPSGameInstanceSubsystem::Get(this);
+	}
+	return GameInstanceSubsystemInternal.Get();
+}
+
+// Returns the last published immutable progression of all local players
+FPSProgressionSnapshotPtr UPSWorldSubsystem::GetProgressionSnapshot() const
+{
+	return ProgressionSnapshotPublisherInternal->Get();
+}
+
+// Copies the progression of all local players to the new immutable snapshot and publishes it, is called on the game thread after each committed change
+void UPSWorldSubsystem::PublishProgressionSnapshot(bool bIsRowsChanged/* = true*/)
+{
+	check(IsInGameThread());
+
+	// Readers keep using the previous snapshot while the new one is built, its rows are shared if they are not changed
+	const FPSProgressionSnapshotPtr PreviousSnapshot = bIsRowsChanged ? nullptr : ProgressionSnapshotPublisherInternal->Get();
+	const TSharedRef<FPSProgressionSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FPSProgressionSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->Version = ++ProgressionSnapshotVersionInternal;
+	NewSnapshot->Players.Reserve(LocalPlayersInternal.Num());
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < LocalPlayersInternal.Num(); ++LocalPlayerIndex)
+	{
+		const FPSLocalPlayerData& LocalPlayerData = LocalPlayersInternal[LocalPlayerIndex];
+		FPSPlayerSnapshot& PlayerSnapshot = NewSnapshot->Players.AddDefaulted_GetRef();
+		PlayerSnapshot.CurrentRowName = LocalPlayerData.CurrentRowName;
+		if (PreviousSnapshot.IsValid() && PreviousSnapshot->GetPlayer(LocalPlayerIndex).Rows.IsValid())
+		{
+			PlayerSnapshot.Rows = PreviousSnapshot->GetPlayer(LocalPlayerIndex).Rows;
+		}
+		else if (LocalPlayerData.SaveGameData)
+		{
+			PlayerSnapshot.Rows = MakeShared<TMap<FName, FPSSaveToDiskData>, ESPMode::ThreadSafe>(LocalPlayerData.SaveGameData->GetProgressionSettingsRowDataInternal());
+		}
+	}
+
+	if (PreviousSnapshot.IsValid() && PreviousSnapshot->PointsToUnlock.IsValid())
+	{
+		NewSnapshot->PointsToUnlock = PreviousSnapshot->PointsToUnlock;
+	}
+	else
+	{
+		// Only settings that are already copied are published, so the data asset is never loaded synchronously from here
+		static const TMap<FName, FPSRowData> EmptySettings;
+		const UPSGameInstanceSubsystem* GameInstanceSubsystem = GetGameInstanceSubsystem();
+		const TMap<FName, FPSRowData>& ProgressionSettingsData = GameInstanceSubsystem ? GameInstanceSubsystem->GetProgressionSettings() : EmptySettings;
+		const TSharedRef<TMap<FName, float>, ESPMode::ThreadSafe> PointsToUnlock = MakeShared<TMap<FName, float>, ESPMode::ThreadSafe>();
+		PointsToUnlock->Reserve(ProgressionSettingsData.Num());
+		for (const TTuple<FName, FPSRowData>& Row : ProgressionSettingsData)
+		{
+			PointsToUnlock->Add(Row.Key, Row.Value.PointsToUnlock);
+		}
+		NewSnapshot->PointsToUnlock = PointsToUnlock;
+	}
+
+	ProgressionSnapshotPublisherInternal->Publish(NewSnapshot);
+}
+
 // Set the progression system component
 void UPSWorldSubsystem::SetHUDComponent(UPSHUDComponent* MyHUDComponent)
 {
@@ -106,37 +300,84 @@ void UPSWorldSubsystem::SetHUDComponent(UPSHUDComponent* MyHUDComponent)
 	{
 		return;
 	}
-	PSHUDComponentInternal = MyHUDComponent;
+
+	const int32 LocalPlayerIndex = GetLocalPlayerIndex(MyHUDComponent);
+	GetOrAddLocalPlayerData(LocalPlayerIndex).HUDComponent = MyHUDComponent;
+
+	// The primary profile is loaded on initialization, other players load their own profile once they appear
+	LoadLocalPlayerSave(LocalPlayerIndex);
 }
 
-// Set the progression system spot component
+// Registers the spot by the player tag of its character, is called once the spot is initialized or streamed in
 void UPSWorldSubsystem::RegisterSpotComponent(UPSSpotComponent* MyHUDComponent)
 {
 	if (!ensureMsgf(MyHUDComponent, TEXT("ASSERT: [%i] %hs:\n'MyHUDComponent' is null!"), __LINE__, __FUNCTION__))
 	{
 		return;
 	}
-	PSSpotComponentArrayInternal.AddUnique(MyHUDComponent);
-	MyHUDComponent->OnSpotComponentReady.AddDynamic(this, &UPSWorldSubsystem::OnSpotComponentLoad);
+	SpotComponentsByPlayerTagInternal.Add(MyHUDComponent->GetMeshChecked().GetPlayerTag(), MyHUDComponent);
+
+	// The spot might be streamed in after the character was chosen, so it catches up with the current row
+	SetCurrentSpotComponent(MyHUDComponent);
+}
+
+// Removes the spot once it's unregistered or streamed out, so no stale spots are kept
+void UPSWorldSubsystem::UnregisterSpotComponent(UPSSpotComponent* SpotComponent)
+{
+	if (!SpotComponent)
+	{
+		return;
+	}
+
+	// Another spot of the same character might be registered after this one was streamed in again
+	const UMySkeletalMeshComponent* Mesh = SpotComponent->GetMySkeletalMeshComponent();
+	const FPlayerTag PlayerTag = Mesh ? Mesh->GetPlayerTag() : FPlayerTag::None;
+	const TWeakObjectPtr<UPSSpotComponent>* RegisteredSpot = SpotComponentsByPlayerTagInternal.Find(PlayerTag);
+	if (RegisteredSpot && RegisteredSpot->Get() == SpotComponent)
+	{
+		SpotComponentsByPlayerTagInternal.Remove(PlayerTag);
+	}
+
+	for (FPSLocalPlayerData& LocalPlayerData : LocalPlayersInternal)
+	{
+		if (LocalPlayerData.SpotComponent == SpotComponent)
+		{
+			LocalPlayerData.SpotComponent = nullptr;
+		}
+	}
 }
 
+// Returns the registered spot of given character, is null if the spot is not streamed in
+UPSSpotComponent* UPSWorldSubsystem::FindSpotComponent(const FPlayerTag& PlayerTag) const
+{
+	const TWeakObjectPtr<UPSSpotComponent>* FoundSpot = SpotComponentsByPlayerTagInternal.Find(PlayerTag);
+	return FoundSpot ? FoundSpot->Get() : nullptr;
+}
+
+// Set the progression system spot component as current for all local players whose character is on this spot
 void UPSWorldSubsystem::SetCurrentSpotComponent(UPSSpotComponent* MyHUDComponent)
 {
 	if (!ensureMsgf(MyHUDComponent, TEXT("ASSERT: [%i] %hs:\n'MyHUDComponent' is null!"), __LINE__, __FUNCTION__))
 	{
 		return;
 	}
-	PSCurrentSpotComponentInternal = MyHUDComponent;
+
+	const FName* SpotRowName = RowNamesByPlayerTagInternal.Find(MyHUDComponent->GetMeshChecked().GetPlayerTag());
+	for (FPSLocalPlayerData& LocalPlayerData : LocalPlayersInternal)
+	{
+		if (SpotRowName && LocalPlayerData.CurrentRowName == *SpotRowName)
+		{
+			LocalPlayerData.SpotComponent = MyHUDComponent;
+		}
+	}
 }
 
 // Called when progression module ready
 void UPSWorldSubsystem::OnInitialized_Implementation()
 {
-	StarDynamicProgressMaterial = UMaterialInstanceDynamic::Create(UPSDataAsset::Get().GetDynamicProgressionMaterial(), this);
-	if (!ensureMsgf(StarDynamicProgressMaterial, TEXT("ASSERT: [%i] %hs:\n'StarDynamicProgressMaterial' is null!"), __LINE__, __FUNCTION__))
-	{
-		return;
-	}
+	// The game state is taken once, then it's kept by changes
+	INC_DWORD_STAT(STAT_PSGlobalLookups);
+	CurrentGameStateInternal = AMyGameStateBase::GetCurrentGameState();
 
 	// Subscribe events on player type changed and Character spawned
 	BIND_ON_LOCAL_CHARACTER_READY(this, ThisClass::OnLocalCharacterReady);
@@ -145,6 +386,61 @@ void UPSWorldSubsystem::OnInitialized_Implementation()
 	BIND_ON_GAME_STATE_CHANGED(this, ThisClass::OnGameStateChanged);
 }
 
+// Subscribes Blueprint adapters and own handlers to the progression events
+void UPSWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Rows received from the server are written to local saves by this subsystem
+	if (UPSReplicationSubsystem* ReplicationSubsystem = Collection.InitializeDependency<UPSReplicationSubsystem>())
+	{
+		ReplicationSubsystem->SetProgressionOwner(this);
+	}
+
+	// Stars of each local player are refreshed on each frame of its count-up animation
+	StarsCountUpInternal.OnUpdated.BindUObject(this, &ThisClass::OnStarsCountUpUpdated);
+
+	// The empty snapshot is published first, so readers never get null, settings are not loaded yet and are published once the data table stage is finished
+	PublishProgressionSnapshot();
+
+	// Only changed rows are recomputed in the presentation cache on the next save
+	EventBusInternal.ProgressChanged.Subscribe(FPSEventBus::FProgressChangedHandler::CreateWeakLambda(this, [this](const FPSProgressChangedEvent& Event)
+	{
+		MarkPresentationRowDirty(Event.RowName, Event.LocalPlayerIndex);
+	}));
+	EventBusInternal.LevelUnlocked.Subscribe(FPSEventBus::FLevelUnlockedHandler::CreateWeakLambda(this, [this](const FPSLevelUnlockedEvent& Event)
+	{
+		MarkPresentationRowDirty(Event.RowName, Event.LocalPlayerIndex);
+	}));
+
+	// Blueprint adapters are called after native listeners
+	constexpr int32 AdapterPriority = FPSEventBus::BlueprintAdapterPriority;
+	EventBusInternal.RowChanged.Subscribe(FPSEventBus::FRowChangedHandler::CreateWeakLambda(this, [this](const FPSRowChangedEvent& Event)
+	{
+		OnCurrentRowDataChanged.Broadcast(Event.PlayerTag);
+	}), AdapterPriority);
+	EventBusInternal.ProgressChanged.Subscribe(FPSEventBus::FProgressChangedHandler::CreateWeakLambda(this, [this](const FPSProgressChangedEvent& Event)
+	{
+		OnProgressChanged.Broadcast(Event.RowName, Event.PreviousProgression, Event.NewProgression);
+	}), AdapterPriority);
+	EventBusInternal.LevelUnlocked.Subscribe(FPSEventBus::FLevelUnlockedHandler::CreateWeakLambda(this, [this](const FPSLevelUnlockedEvent& Event)
+	{
+		OnLevelUnlocked.Broadcast(Event.RowName);
+	}), AdapterPriority);
+	EventBusInternal.Initialized.Subscribe(FPSEventBus::FInitializedHandler::CreateWeakLambda(this, [this](const FPSInitializedEvent& Event)
+	{
+		(Event.bIsSucceeded ? OnInitialize : OnInitializeFailed).Broadcast();
+	}), AdapterPriority);
+
+	EventBusInternal.SpotReady.Subscribe(FPSEventBus::FSpotReadyHandler::CreateWeakLambda(this, [this](const FPSSpotReadyEvent& Event)
+	{
+		if (UPSSpotComponent* SpotComponent = Cast<UPSSpotComponent>(Event.SpotComponent))
+		{
+			OnSpotComponentLoad(SpotComponent, Event.LocalPlayerIndex);
+		}
+	}));
+}
+
 // Called when world is ready to start gameplay before the game mode transitions to the correct state and call BeginPlay on all actors 
 void UPSWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
@@ -154,16 +450,205 @@ void UPSWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 // Clears all transient data created by this subsystem
 void UPSWorldSubsystem::Deinitialize()
 {
+	StopStarsCountUp();
+	StopMatchProgress();
+	FWorldDelegates::OnWorldPostActorTick.Remove(DirtyFlushHandleInternal);
+	DirtyFlushHandleInternal.Reset();
+	EventBusInternal.Reset();
+
 	Super::Deinitialize();
 }
 
 // Is called to initialize the world subsystem. It's a BeginPlay logic for the PS module
 void UPSWorldSubsystem::OnWorldSubSystemInitialize_Implementation()
 {
-	// Load save game data of the Progression system
+	// Load the data asset and save game data of the Progression system concurrently
+	StartInitialization();
+}
+
+// Starts all initialization stages that don't depend on each other: the data asset and the primary save are loaded concurrently
+void UPSWorldSubsystem::StartInitialization()
+{
+	if (bIsProgressionReadyInternal || bIsProgressionFailedInternal || PendingInitStagesInternal != 0)
+	{
+		// Is called by each HUD component, but the module is initialized only once
+		return;
+	}
+
+	// All stages are pending before any of them is started, so a stage finished synchronously doesn't complete the initialization too early
+	InitStageDurationsInternal.Empty();
+	InitStageStartTimesInternal.Empty();
+	InitStageStartTimesInternal.Add(EPSInitStage::None, FPlatformTime::Seconds());
+	PendingInitStagesInternal = static_cast<int32>(EPSInitStage::All);
+
+	// The save file is read and decoded on a worker thread by AsyncLoadGameFromSlot while the data asset is streamed
+	StartInitStage(EPSInitStage::SaveGame);
+	LoadLocalPlayerSave(0);
+
+	StartInitStage(EPSInitStage::DataAsset);
+	if (PSDataAssetInternal.IsValid())
+	{
+		OnDataAssetLoaded();
+		return;
+	}
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	DataAssetLoadHandleInternal = StreamableManager.RequestAsyncLoad(PSDataAssetInternal.ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &ThisClass::OnDataAssetLoaded));
+	if (!DataAssetLoadHandleInternal.IsValid())
+	{
+		// The path is not valid, the data asset is loaded synchronously to report the error as before
+		OnDataAssetLoaded();
+	}
+}
+
+// Remembers the start time of the stage and marks it as pending
+void UPSWorldSubsystem::StartInitStage(EPSInitStage Stage)
+{
+	PendingInitStagesInternal |= static_cast<int32>(Stage);
+	InitStageStartTimesInternal.Add(Stage, FPlatformTime::Seconds());
+}
+
+// Reports the duration of the stage and finishes initialization once all stages are finished
+void UPSWorldSubsystem::FinishInitStage(EPSInitStage Stage)
+{
+	const int32 StageFlag = static_cast<int32>(Stage);
+	if (!(PendingInitStagesInternal & StageFlag))
+	{
+		return;
+	}
+
+	PendingInitStagesInternal &= ~StageFlag;
+	const double* StartTime = InitStageStartTimesInternal.Find(Stage);
+	const float Duration = StartTime ? static_cast<float>(FPlatformTime::Seconds() - *StartTime) : 0.f;
+	InitStageDurationsInternal.Add(Stage, Duration);
+	UE_LOG(LogProgressionSystem, Verbose, TEXT("%hs: '%s' stage is finished in %.2f ms"), __FUNCTION__, *UEnum::GetValueAsString(Stage), Duration * 1000.f);
+
+	if (PendingInitStagesInternal == 0)
+	{
+		FinishInitialization();
+	}
+}
+
+// Returns how long the initialization stage took in seconds, 0 if it's not finished yet
+float UPSWorldSubsystem::GetInitStageDuration(EPSInitStage Stage) const
+{
+	const float* FoundDuration = InitStageDurationsInternal.Find(Stage);
+	return FoundDuration ? *FoundDuration : 0.f;
+}
+
+// Is called once the data asset is loaded, starts stages that depend on it
+void UPSWorldSubsystem::OnDataAssetLoaded()
+{
+	DataAssetLoadHandleInternal.Reset();
+	if (!ensureMsgf(GetPSDataAsset(), TEXT("ASSERT: [%i] %hs:\n'PSDataAsset' is not loaded!"), __LINE__, __FUNCTION__))
+	{
+		// Other stages depend on the data asset, so the pipeline fails instead of never becoming ready
+		FailInitialization(EPSInitStage::DataAsset);
+		return;
+	}
+	FinishInitStage(EPSInitStage::DataAsset);
+
+	// Rows keep pointers to UObjects, so they are copied on the game thread, once per game instance
+	StartInitStage(EPSInitStage::DataTable);
+	GetProgressionSettingsData();
+	PublishProgressionSnapshot();
+	FinishInitStage(EPSInitStage::DataTable);
+
+	// Spawning is spread over next frames by the pool manager, while the save might be still decoded
+	StartInitStage(EPSInitStage::StarsPool);
+	PrewarmStarsPool();
+}
+
+// Spawns star actors of the largest row to the pool, so the first stars are displayed without spawning
+void UPSWorldSubsystem::PrewarmStarsPool()
+{
+	const UPSDataAsset& PSDataAsset = GetPSDataAssetChecked();
+	int32 StarsToPrewarmNum = 0;
+	for (const TTuple<FName, FPSRowData>& Row : GetProgressionSettingsData())
+	{
+		StarsToPrewarmNum = FMath::Max(StarsToPrewarmNum, PSDataAsset.GetStarsToDisplayNum(Row.Value.PointsToUnlock));
+	}
+	StarsToPrewarmNum = FMath::Min(StarsToPrewarmNum, PSDataAsset.GetMaxPooledStarActors());
+
+	if (StarsToPrewarmNum <= 0 || !PrewarmStarHandlesInternal.IsEmpty())
+	{
+		FinishInitStage(EPSInitStage::StarsPool);
+		return;
+	}
+
+	// Actors are returned right away, so they are inactive in the pool until stars are displayed
+	const TWeakObjectPtr<ThisClass> WeakThis = this;
+	const FOnSpawnAllCallback OnPrewarmCompleted = [WeakThis](const TArray<FPoolObjectData>& CreatedObjects)
+	{
+		if (UPSWorldSubsystem* This = WeakThis.Get())
+		{
+			for (const FPoolObjectData& CreatedObject : CreatedObjects)
+			{
+				This->RegisterTakenStarActor(CreatedObject.GetChecked<APSStarActor>());
+			}
+			This->GetPoolManagerChecked().ReturnToPoolArray(This->PrewarmStarHandlesInternal);
+			This->PrewarmStarHandlesInternal.Empty();
+			This->FinishInitStage(EPSInitStage::StarsPool);
+		}
+	};
+	GetPoolManagerChecked().TakeFromPoolArray(PrewarmStarHandlesInternal, PSDataAsset.GetStarActorClass(), StarsToPrewarmNum, OnPrewarmCompleted);
+}
+
+// Applies the primary save and broadcasts the single ready event once all stages are finished
+void UPSWorldSubsystem::FinishInitialization()
+{
+	const double* StartTime = InitStageStartTimesInternal.Find(EPSInitStage::None);
+	const float TimeToReady = StartTime ? static_cast<float>(FPlatformTime::Seconds() - *StartTime) : 0.f;
+	InitStageDurationsInternal.Add(EPSInitStage::None, TimeToReady);
+	InitStageStartTimesInternal.Empty();
+	UE_LOG(LogProgressionSystem, Verbose, TEXT("%hs: progression is ready in %.2f ms"), __FUNCTION__, TimeToReady * 1000.f);
+
+	USaveGame* PrimarySaveGame = PendingPrimarySaveGameInternal;
+	PendingPrimarySaveGameInternal = nullptr;
+	ApplyLoadedSaveGame(GetSaveSlotName(0), 0, PrimarySaveGame);
+
+	bIsProgressionReadyInternal = true;
+	OnInitialized();
+	EventBusInternal.Initialized.Broadcast(FPSInitializedEvent{});
+}
+
+// Stops initialization because of the failed stage and broadcasts the failed result
+void UPSWorldSubsystem::FailInitialization(EPSInitStage FailedStage)
+{
+	UE_LOG(LogProgressionSystem, Error, TEXT("%hs: '%s' stage failed, progression is not available in this world"), __FUNCTION__, *UEnum::GetValueAsString(FailedStage));
+
+	// The primary save is still being loaded, it's discarded once received
+	PendingInitStagesInternal = 0;
+	InitStageStartTimesInternal.Empty();
+	PendingPrimarySaveGameInternal = nullptr;
+	bIsProgressionFailedInternal = true;
+
+	EventBusInternal.Initialized.Broadcast(FPSInitializedEvent{/*bIsSucceeded*/false});
+}
+
+// Starts loading the save profile of the local player, does nothing if it's already loaded or being loaded
+void UPSWorldSubsystem::LoadLocalPlayerSave(int32 LocalPlayerIndex)
+{
+	FPSLocalPlayerData& LocalPlayerData = GetOrAddLocalPlayerData(LocalPlayerIndex);
+	if (LocalPlayerData.SaveGameData || LocalPlayerData.bIsSaveLoading)
+	{
+		return;
+	}
+
+	// The profile loaded in the previous world of this game instance is reused without reading it from disk
+	const FString SaveSlotName = GetSaveSlotName(LocalPlayerIndex);
+	const UPSGameInstanceSubsystem* GameInstanceSubsystem = GetGameInstanceSubsystem();
+	if (UPSSaveGameData* LoadedSaveGameData = GameInstanceSubsystem ? GameInstanceSubsystem->FindSaveGame(SaveSlotName) : nullptr)
+	{
+		OnAsyncLoadGameFromSlotCompleted(SaveSlotName, LocalPlayerIndex, LoadedSaveGameData);
+		return;
+	}
+
+	// The local player index is passed as the user index, so the callback knows whose profile is loaded
+	LocalPlayerData.bIsSaveLoading = true;
 	FAsyncLoadGameFromSlotDelegate AsyncLoadGameFromSlotDelegate;
 	AsyncLoadGameFromSlotDelegate.BindUObject(this, &ThisClass::OnAsyncLoadGameFromSlotCompleted);
-	UGameplayStatics::AsyncLoadGameFromSlot(UPSSaveGameData::GetSaveSlotName(), UPSSaveGameData::GetSaveSlotIndex(), AsyncLoadGameFromSlotDelegate);
+	UGameplayStatics::AsyncLoadGameFromSlot(SaveSlotName, LocalPlayerIndex, AsyncLoadGameFromSlotDelegate);
 }
 
 // Is called when a player character is ready
@@ -179,31 +664,47 @@ void UPSWorldSubsystem::OnLocalCharacterReady_Implementation(APlayerCharacter* P
 // Is called when a player has been changed
 void UPSWorldSubsystem::OnPlayerTypeChanged_Implementation(FPlayerTag PlayerTag)
 {
-	// todo refactor: in SetCurrentRowByTag function on broadcast OnCurrentRowDataChanged create a function which will
-	// perform all logic after this function call
-	SetCurrentRowByTag(PlayerTag);
-
-	for (UPSSpotComponent* SpotComponent : PSSpotComponentArrayInternal)
+	// The event has no instigator, so the row is changed for each local player that switched to this character
+	bool bIsAnyPlayerFound = false;
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < LocalPlayersInternal.Num(); ++LocalPlayerIndex)
 	{
-		if (SpotComponent->GetMeshChecked().GetPlayerTag() == PlayerTag)
+		const APlayerCharacter* PlayerCharacter = GetLocalPlayerCharacter(LocalPlayerIndex);
+		if (PlayerCharacter && PlayerCharacter->GetPlayerTag() == PlayerTag)
 		{
-			PSCurrentSpotComponentInternal = SpotComponent;
-			UpdateProgressionStarActors();
+			bIsAnyPlayerFound = true;
+			SetCurrentRowByTag(PlayerTag, LocalPlayerIndex);
 		}
 	}
+
+	if (!bIsAnyPlayerFound)
+	{
+		// Characters might be not possessed yet, so it's the primary player as in a single player game
+		SetCurrentRowByTag(PlayerTag);
+	}
+
+	if (UPSSpotComponent* SpotComponent = FindSpotComponent(PlayerTag))
+	{
+		SetCurrentSpotComponent(SpotComponent);
+		MarkProgressionDirty(EPSDirtyFlags::Stars);
+	}
 }
 
 // Called when the current game state was changed
 void UPSWorldSubsystem::OnGameStateChanged_Implementation(ECurrentGameState CurrentGameState)
 {
+	CurrentGameStateInternal = CurrentGameState;
+
 	switch (CurrentGameState)
 	{
 	case ECurrentGameState::Menu:
 		// refresh 3D Stars actors
-		UpdateProgressionStarActors();
+		MarkProgressionDirty(EPSDirtyFlags::Stars);
+		StopMatchProgress();
 		break;
 	case ECurrentGameState::GameStarting:
 		// Show Progression Menu widget in Main Menu
+		// In-match events of the new match are accumulated from zero
+		StartMatchProgress();
 		break;
 	default:
 		break;
@@ -211,23 +712,28 @@ void UPSWorldSubsystem::OnGameStateChanged_Implementation(ECurrentGameState Curr
 }
 
 // Always set first levels as unlocked on begin play
-void UPSWorldSubsystem::SetFirstElementAsCurrent()
+void UPSWorldSubsystem::SetFirstElementAsCurrent(int32 LocalPlayerIndex)
 {
-	FName FirstSaveToDiskRow = GetFirstSaveToDiskRowName();
+	FName FirstSaveToDiskRow = GetFirstSaveToDiskRowName(LocalPlayerIndex);
 	
 	// early return if first element is not valid
 	if (!ensureMsgf(!FirstSaveToDiskRow.IsNone(), TEXT("ASSERT: [%i] %s:\n'FirstSaveToDiskRow' is not valid!"), __LINE__, *FString(__FUNCTION__)))
 	{
 		return;
 	}
-	if (!ensureMsgf(SaveGameDataInternal, TEXT("ASSERT: [%i] %s:\n'SaveGameDataInternal' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+	FPSLocalPlayerData& LocalPlayerData = GetOrAddLocalPlayerData(LocalPlayerIndex);
+	if (!ensureMsgf(LocalPlayerData.SaveGameData, TEXT("ASSERT: [%i] %s:\n'SaveGameData' is not valid!"), __LINE__, *FString(__FUNCTION__)))
 	{
 		return;
 	}
 
-	CurrentRowNameInternal = FirstSaveToDiskRow;
-	SaveGameDataInternal->UnlockLevelByName(CurrentRowNameInternal);
-	SaveDataAsync();
+	LocalPlayerData.CurrentRowName = FirstSaveToDiskRow;
+
+	// A profile reused from the previous world has the first level unlocked already, so it's not written to disk again
+	if (LocalPlayerData.SaveGameData->UnlockLevelByName(FirstSaveToDiskRow))
+	{
+		SaveDataAsync(LocalPlayerIndex);
+	}
 }
 
 // Spawn/add the stars actors for a spot
@@ -237,9 +743,11 @@ void UPSWorldSubsystem::UpdateProgressionStarActors()
 
 	if (!PoolActorHandlersInternal.IsEmpty())
 	{
-		UPoolManagerSubsystem::Get().ReturnToPoolArray(PoolActorHandlersInternal);
+		GetPoolManagerChecked().ReturnToPoolArray(PoolActorHandlersInternal);
 		PoolActorHandlersInternal.Empty();
 	}
+	StarActorsInternal.Reset();
+
 	// --- Prepare spawn request
 	const TWeakObjectPtr<ThisClass> WeakThis = this;
 	const FOnSpawnAllCallback OnTakeActorsFromPoolCompleted = [WeakThis](const TArray<FPoolObjectData>& CreatedObjects)
@@ -252,201 +760,845 @@ void UPSWorldSubsystem::UpdateProgressionStarActors()
 
 	// --- Spawn actors
 	const FPSRowData& CurrentSettingsRowData = GetCurrentProgressionSettingsRowByName();
-	if (CurrentSettingsRowData.PointsToUnlock)
+	const int32 StarsToDisplayNum = GetPSDataAssetChecked().GetStarsToDisplayNum(CurrentSettingsRowData.PointsToUnlock);
+	if (StarsToDisplayNum > 0)
 	{
-		UPoolManagerSubsystem::Get().TakeFromPoolArray(PoolActorHandlersInternal, UPSDataAsset::Get().GetStarActorClass(), CurrentSettingsRowData.PointsToUnlock, OnTakeActorsFromPoolCompleted, ESpawnRequestPriority::High);
+		GetPoolManagerChecked().TakeFromPoolArray(PoolActorHandlersInternal, GetPSDataAssetChecked().GetStarActorClass(), StarsToDisplayNum, OnTakeActorsFromPoolCompleted, ESpawnRequestPriority::High);
 	}
 }
 
 // Dynamically adds Star actors which representing unlocked and locked progression above the character
 void UPSWorldSubsystem::OnTakeActorsFromPoolCompleted(const TArray<FPoolObjectData>& CreatedObjects)
 {
-	const FPSRowData& CurrentSettingsRowData = GetCurrentProgressionSettingsRowByName();
-	const FPSSaveToDiskData& CurrentSaveToDiskRowData = GetCurrentSaveToDiskRowByName();
-
-	float CurrentAmountOfUnlocked = CurrentSaveToDiskRowData.CurrentLevelProgression;
-
-	FVector PreviousActorLocation = FVector::Zero();
+	// All transforms are computed at once, actors only receive the finished ones
+	const TArray<FTransform>& StarTransforms = GetStarsLayout(GetCurrentRowName(), CreatedObjects.Num()).StarTransforms;
 
 	// Setup spawned widget
-	for (const FPoolObjectData& CreatedObject : CreatedObjects)
+	for (int32 Index = 0; Index < CreatedObjects.Num(); ++Index)
 	{
-		APSStarActor& SpawnedActor = CreatedObject.GetChecked<APSStarActor>();
-
-		float StarAmount = FMath::Clamp(CurrentAmountOfUnlocked, 0.0f, 1.0f);
-		if (CurrentAmountOfUnlocked > 0)
-		{
-			SpawnedActor.UpdateStarActorMeshMaterial(StarDynamicProgressMaterial, StarAmount, EPSStarActorState::Unlocked);
-		}
-		else
-		{
-			SpawnedActor.UpdateStarActorMeshMaterial(StarDynamicProgressMaterial, 1, EPSStarActorState::Locked);
-		}
+		APSStarActor& SpawnedActor = CreatedObjects[Index].GetChecked<APSStarActor>();
+		RegisterTakenStarActor(SpawnedActor);
+		SpawnedActor.OnInitialized(StarTransforms[Index]);
+		StarActorsInternal.Emplace(&SpawnedActor);
+	}
 
-		CurrentAmountOfUnlocked -= StarAmount;
+	UpdateStarActorsFills();
 
-		SpawnedActor.OnInitialized(PreviousActorLocation);
-		PreviousActorLocation = SpawnedActor.GetActorLocation();
+	// Start evaluating significance of new stars to throttle animations of invisible ones
+	if (UWorld* World = GetWorld())
+	{
+		StarsSignificanceInternal.Start(*World, StarsSignificanceUpdateIntervalInternal, FTimerDelegate::CreateUObject(this, &ThisClass::UpdateStarsSignificance));
 	}
 }
 
-// Returns current spot component returns null if spot is not found
-UPSSpotComponent* UPSWorldSubsystem::GetCurrentSpot() const
+// Applies the displayed level progression to the fill of each star actor
+void UPSWorldSubsystem::UpdateStarActorsFills()
 {
-	APlayerCharacter* PlayerCharacter = UMyBlueprintFunctionLibrary::GetLocalPlayerCharacter();
-	if (!PlayerCharacter)
+	if (StarActorsInternal.IsEmpty() || !GetCurrentSaveGameData())
 	{
-		return nullptr;
+		return;
 	}
 
-	const FPlayerTag& PlayerTag = PlayerCharacter->GetPlayerTag();
-	if (PSSpotComponentArrayInternal.IsEmpty() || !PlayerTag.IsValid())
+	const TArray<float>& StarFills = GetDisplayedPresentationData().StarFills;
+	for (int32 Index = 0; Index < StarActorsInternal.Num(); ++Index)
 	{
-		return nullptr;
-	}
+		APSStarActor* StarActor = StarActorsInternal[Index];
+		if (!StarActor)
+		{
+			continue;
+		}
 
-	for (UPSSpotComponent* SpotComponent : PSSpotComponentArrayInternal)
-	{
-		if (SpotComponent && SpotComponent->GetMeshChecked().GetPlayerTag() == PlayerTag)
+		const float StarFill = StarFills.IsValidIndex(Index) ? StarFills[Index] : 0.f;
+		if (StarFill > 0.f)
+		{
+			StarActor->UpdateStarActorMeshMaterial(StarFill, EPSStarActorState::Unlocked);
+		}
+		else
 		{
-			return SpotComponent;
+			StarActor->UpdateStarActorMeshMaterial(1, EPSStarActorState::Locked);
 		}
 	}
-	return nullptr;
 }
 
-// Triggers when a spot is loaded
-void UPSWorldSubsystem::OnSpotComponentLoad_Implementation(UPSSpotComponent* SpotComponent)
+// Returns the cached presentation of the given row, is empty if the row is not found
+const FPSPresentationData& UPSWorldSubsystem::GetPresentationData(FName RowName, int32 LocalPlayerIndex) const
 {
-	if (!ensureMsgf(SpotComponent, TEXT("ASSERT: [%i] %s:\n'SpotComponent' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+	const FPSPresentationData* FoundPresentation = GetLocalPlayerData(LocalPlayerIndex).PresentationCache.Find(RowName);
+	return FoundPresentation ? *FoundPresentation : FPSPresentationData::EmptyData;
+}
+
+// Returns the presentation currently displayed for the current row of the local player, it's the cached one unless count-up is playing
+const FPSPresentationData& UPSWorldSubsystem::GetDisplayedPresentationData(int32 LocalPlayerIndex)
+{
+	if (!IsStarsCountUpPlaying(LocalPlayerIndex))
 	{
-		return;
+		return GetPresentationData(GetCurrentRowName(LocalPlayerIndex), LocalPlayerIndex);
 	}
 
-	PSCurrentSpotComponentInternal = SpotComponent;
+	FPSLocalPlayerData& LocalPlayerData = LocalPlayersInternal[LocalPlayerIndex];
+	MakePresentationData(LocalPlayerData.CurrentRowName, GetDisplayedLevelProgression(LocalPlayerIndex), LocalPlayerData.SaveGameData, LocalPlayerData.CountUpPresentation);
+	return LocalPlayerData.CountUpPresentation;
 }
 
-// Is called from AsyncLoadGameFromSlot once Save Game is loaded, or null if it failed to load.
-void UPSWorldSubsystem::OnAsyncLoadGameFromSlotCompleted_Implementation(const FString& SlotName, int32 UserIndex, USaveGame* SaveGame)
+// Recomputes the presentation of all rows of the local player, is called after the save is loaded or reset
+void UPSWorldSubsystem::RebuildPresentationCache(int32 LocalPlayerIndex)
 {
-	// load from data table
-	const UDataTable* ProgressionDataTable = UPSDataAsset::Get().GetProgressionDataTable();
-	if (!ensureMsgf(ProgressionDataTable, TEXT("ASSERT: [%i] %s:\n'ProgressionDataTable' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+	if (!LocalPlayersInternal.IsValidIndex(LocalPlayerIndex) || !LocalPlayersInternal[LocalPlayerIndex].SaveGameData)
 	{
 		return;
 	}
-	UMyDataTable::GetRows(*ProgressionDataTable, ProgressionSettingsDataInternal);
 
-	SaveGameDataInternal = Cast<UPSSaveGameData>(SaveGame);
-
-	if (!SaveGameDataInternal)
+	FPSLocalPlayerData& LocalPlayerData = LocalPlayersInternal[LocalPlayerIndex];
+	RowNamesByPlayerTagInternal.Reset();
+	for (const TTuple<FName, FPSRowData>& Row : GetProgressionSettingsData())
 	{
-		//  there is no save game file, or it is corrupted, create a new one
-		SaveGameDataInternal = Cast<UPSSaveGameData>(UGameplayStatics::CreateSaveGameObject(UPSSaveGameData::StaticClass()));
+		RowNamesByPlayerTagInternal.Add(Row.Value.Character, Row.Key);
 
-		if (SaveGameDataInternal)
-		{
-			for (const TTuple<FName, FPSRowData>& Row : ProgressionSettingsDataInternal)
-			{
-				SaveGameDataInternal->SetProgressionMap(Row.Key, FPSSaveToDiskData::EmptyData);
-			}
-		}
+		const float LevelProgression = LocalPlayerData.SaveGameData->GetSaveToDiskDataByName(Row.Key).CurrentLevelProgression;
+		FPSPresentationData& PresentationData = LocalPlayerData.PresentationCache.FindOrAdd(Row.Key);
+		MakePresentationData(Row.Key, LevelProgression, LocalPlayerData.SaveGameData, PresentationData);
+
+		// Warm up the layout, so the stars of switched character are placed without computing it
+		GetStarsLayout(Row.Key, PresentationData.StarFills.Num());
 	}
+	LocalPlayerData.DirtyPresentationRows.Reset();
 
-	SetFirstElementAsCurrent();
-	OnInitialized();
-	OnInitialize.Broadcast();
+	// Presentation is rebuilt after each load, so it's when the progression is committed
+	PublishProgressionSnapshot();
 }
 
-// Destroy all star actors that should not be available by other objects anymore.
+// Recomputes the presentation only of rows changed since the last update, is called after each save
+void UPSWorldSubsystem::UpdatePresentationCache(int32 LocalPlayerIndex)
+{
+	if (!LocalPlayersInternal.IsValidIndex(LocalPlayerIndex)
+		|| !LocalPlayersInternal[LocalPlayerIndex].SaveGameData
+		|| LocalPlayersInternal[LocalPlayerIndex].DirtyPresentationRows.IsEmpty())
+	{
+		return;
+	}
+
+	FPSLocalPlayerData& LocalPlayerData = LocalPlayersInternal[LocalPlayerIndex];
+	for (const FName RowName : LocalPlayerData.DirtyPresentationRows)
+	{
+		const float LevelProgression = LocalPlayerData.SaveGameData->GetSaveToDiskDataByName(RowName).CurrentLevelProgression;
+		MakePresentationData(RowName, LevelProgression, LocalPlayerData.SaveGameData, LocalPlayerData.PresentationCache.FindOrAdd(RowName));
+	}
+	LocalPlayerData.DirtyPresentationRows.Reset();
+
+	// Presentation is updated after each save, so it's when the progression is committed
+	PublishProgressionSnapshot();
+}
+
+// Marks the row of the local player to be recomputed in the presentation cache on the next save
+void UPSWorldSubsystem::MarkPresentationRowDirty(FName RowName, int32 LocalPlayerIndex)
+{
+	if (LocalPlayersInternal.IsValidIndex(LocalPlayerIndex)
+		&& !RowName.IsNone())
+	{
+		LocalPlayersInternal[LocalPlayerIndex].DirtyPresentationRows.Add(RowName);
+	}
+}
+
+// Computes the presentation of the row for given level progression
+void UPSWorldSubsystem::MakePresentationData(FName RowName, float LevelProgression, const UPSSaveGameData* SaveGameData, FPSPresentationData& OutPresentationData) const
+{
+	const FPSRowData* RowData = GetProgressionSettingsData().Find(RowName);
+	if (!RowData)
+	{
+		RowData = &FPSRowData::EmptyData;
+	}
+
+	// When stars are compacted, each star represents a segment of points
+	const UPSDataAsset& PSDataAsset = GetPSDataAssetChecked();
+	const float DisplayScale = PSDataAsset.GetStarsDisplayScale(RowData->PointsToUnlock);
+	OutPresentationData.PointsToUnlock = RowData->PointsToUnlock;
+	OutPresentationData.LevelProgression = FMath::Min(LevelProgression, RowData->PointsToUnlock);
+	OutPresentationData.bIsCompacted = DisplayScale < 1.f;
+	OutPresentationData.bIsLevelLocked = SaveGameData ? SaveGameData->GetSaveToDiskDataByName(RowName).IsLevelLocked : true;
+
+	// Each star is filled by the amount of unlocked points it covers, 0 is the locked star
+	const float UnlockedStars = OutPresentationData.LevelProgression * DisplayScale;
+	OutPresentationData.StarFills.SetNumUninitialized(PSDataAsset.GetStarsToDisplayNum(RowData->PointsToUnlock));
+	for (int32 Index = 0; Index < OutPresentationData.StarFills.Num(); ++Index)
+	{
+		OutPresentationData.StarFills[Index] = FMath::Clamp(UnlockedStars - Index, 0.f, 1.f);
+	}
+}
+
+// Marks progression consumers to be refreshed, all marks are coalesced and flushed once after actors tick in this frame
+void UPSWorldSubsystem::MarkProgressionDirty(int32 DirtyFlags)
+{
+	const int32 NewDirtyFlags = DirtyFlags & static_cast<int32>(EPSDirtyFlags::All | EPSDirtyFlags::EndGameResults);
+	if (!NewDirtyFlags)
+	{
+		return;
+	}
+
+	// Each consumer marked again before the flush is an update that was saved
+	INC_DWORD_STAT_BY(STAT_PSUpdatesRequested, FMath::CountBits(NewDirtyFlags));
+	INC_DWORD_STAT_BY(STAT_PSUpdatesCoalesced, FMath::CountBits(NewDirtyFlags & DirtyFlagsInternal));
+
+	DirtyFlagsInternal |= NewDirtyFlags;
+	if (!DirtyFlushHandleInternal.IsValid())
+	{
+		DirtyFlushHandleInternal = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnWorldPostActorTick);
+	}
+}
+
+// Refreshes all dirty consumers at once, is called after actors tick in the frame they were marked
+void UPSWorldSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		FlushDirtyProgression();
+	}
+}
+
+// Adds points earned by an in-match event to the local player, is lock-free and safe to call from any thread
+void UPSWorldSubsystem::PostMatchProgress(int32 LocalPlayerIndex, float Points)
+{
+	// Only the accumulator is touched, the save and local players are changed on the game thread
+	MatchProgressAccumulatorInternal->Post(LocalPlayerIndex, Points);
+}
+
+// Starts accumulating in-match progress from zero, the posted points are reduced once per frame until the match is committed
+void UPSWorldSubsystem::StartMatchProgress()
+{
+	StopMatchProgress();
+	MatchProgressReduceHandleInternal = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnMatchProgressPostActorTick);
+}
+
+// Stops the per-frame reduction and discards in-match progress that is not committed
+void UPSWorldSubsystem::StopMatchProgress()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(MatchProgressReduceHandleInternal);
+	MatchProgressReduceHandleInternal.Reset();
+	MatchProgressAccumulatorInternal->Reset();
+	for (FPSLocalPlayerData& LocalPlayerData : LocalPlayersInternal)
+	{
+		LocalPlayerData.MatchProgress = 0.f;
+	}
+}
+
+// Reduces in-match progress once per frame, is called after actors tick
+void UPSWorldSubsystem::OnMatchProgressPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		ReduceMatchProgress();
+	}
+}
+
+// Adds points posted since the last reduction to the in-match progress of each local player
+void UPSWorldSubsystem::ReduceMatchProgress()
+{
+	FPSProgressAccumulator& Accumulator = *MatchProgressAccumulatorInternal;
+	if (!Accumulator.HasPendingPoints())
+	{
+		return;
+	}
+
+	// Points posted after consuming the players are kept for the next frame
+	Accumulator.ClearPendingPoints();
+	const int32 PlayersNum = FMath::Min(LocalPlayersInternal.Num(), FPSProgressAccumulator::MaxLocalPlayers);
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < PlayersNum; ++LocalPlayerIndex)
+	{
+		FPSLocalPlayerData& LocalPlayerData = LocalPlayersInternal[LocalPlayerIndex];
+		const float Points = Accumulator.Consume(LocalPlayerIndex);
+		LocalPlayerData.MatchProgress += Points;
+
+		// In network games only the server accumulates progress, so the listen server player forwards its points there, points of clients are not trusted
+		UPSReplicationComponent* ReplicationComponent = LocalPlayerData.ReplicationComponent;
+		if (Points != 0.f && ReplicationComponent && ReplicationComponent->GetOwnerRole() == ROLE_Authority)
+		{
+			ReplicationComponent->AddMatchProgress(Points);
+		}
+	}
+}
+
+// Refreshes all dirty consumers and clears the flags
+void UPSWorldSubsystem::FlushDirtyProgression()
+{
+	// Nothing is registered while there are no dirty consumers
+	FWorldDelegates::OnWorldPostActorTick.Remove(DirtyFlushHandleInternal);
+	DirtyFlushHandleInternal.Reset();
+
+	// Flags are reset before refreshing, so consumers marked during the flush are refreshed on the next one
+	const EPSDirtyFlags DirtyFlags = static_cast<EPSDirtyFlags>(DirtyFlagsInternal);
+	DirtyFlagsInternal = 0;
+	INC_DWORD_STAT_BY(STAT_PSUpdatesFlushed, FMath::CountBits(static_cast<uint32>(DirtyFlags)));
+
+	// Results are saved first, so consumers below display the saved progression
+	if (EnumHasAnyFlags(DirtyFlags, EPSDirtyFlags::EndGameResults))
+	{
+		ApplyEndGameResults();
+	}
+
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < LocalPlayersInternal.Num(); ++LocalPlayerIndex)
+	{
+		if (EnumHasAnyFlags(DirtyFlags, EPSDirtyFlags::Spot))
+		{
+			if (UPSSpotComponent* SpotComponent = GetCurrentSpot(LocalPlayerIndex))
+			{
+				SpotComponent->ChangeSpotVisibilityStatus();
+			}
+		}
+
+		// The component of the player that left the game might be already destroyed
+		UPSHUDComponent* HUDComponent = LocalPlayersInternal[LocalPlayerIndex].HUDComponent;
+		if (!IsValid(HUDComponent))
+		{
+			continue;
+		}
+
+		if (EnumHasAnyFlags(DirtyFlags, EPSDirtyFlags::MenuWidget))
+		{
+			HUDComponent->UpdateProgressionMenuWidget();
+		}
+
+		if (EnumHasAnyFlags(DirtyFlags, EPSDirtyFlags::Overlay))
+		{
+			HUDComponent->UpdateLevelUIOverlay();
+		}
+	}
+
+	if (EnumHasAnyFlags(DirtyFlags, EPSDirtyFlags::Stars))
+	{
+		UpdateProgressionStarActors();
+	}
+}
+
+// Starts the count-up animation that fills earned stars in sequence, both in the menu widget and star actors
+void UPSWorldSubsystem::PlayStarsCountUp(float FromPoints, int32 LocalPlayerIndex)
+{
+	if (!GetCurrentSaveGameData(LocalPlayerIndex))
+	{
+		return;
+	}
+
+	StarsCountUpInternal.Stop(LocalPlayerIndex);
+
+	// Duration depends on the amount of displayed stars to fill, so each star is filled for the same time
+	const UPSDataAsset& PSDataAsset = GetPSDataAssetChecked();
+	const float ToPoints = GetCurrentSaveToDiskRowByName(LocalPlayerIndex).CurrentLevelProgression;
+	const float DisplayScale = PSDataAsset.GetStarsDisplayScale(GetCurrentProgressionSettingsRowByName(LocalPlayerIndex).PointsToUnlock);
+	const float Duration = (ToPoints - FromPoints) * DisplayScale * PSDataAsset.GetStarCountUpDuration();
+
+	const USettingsWidget* SettingsWidget = GetSettingsWidget();
+	const bool bIsInstant = !SettingsWidget || SettingsWidget->GetCheckboxValue(PSDataAsset.GetInstantCharacterSwitchTag());
+	if (bIsInstant || Duration <= 0.f)
+	{
+		// Nothing to animate, stars already display the saved progression
+		return;
+	}
+
+	// All local players are counted up on the same clock
+	StarsCountUpInternal.Play(LocalPlayerIndex, FromPoints, Duration);
+
+	// Rewind star actors to the progression before points were earned, the menu widget reads it on its next update
+	if (LocalPlayerIndex == 0)
+	{
+		UpdateStarActorsFills();
+	}
+}
+
+// Stops the count-up animation, stars are displaying the saved level progression
+void UPSWorldSubsystem::StopStarsCountUp()
+{
+	StarsCountUpInternal.StopAll();
+}
+
+// Returns the level progression of the current row displayed by stars, is behind the saved one while count-up is playing
+float UPSWorldSubsystem::GetDisplayedLevelProgression(int32 LocalPlayerIndex) const
+{
+	return StarsCountUpInternal.GetDisplayedProgression(LocalPlayerIndex, GetCurrentSaveToDiskRowByName(LocalPlayerIndex).CurrentLevelProgression);
+}
+
+// Applies the count-up animation of the local player to its stars
+void UPSWorldSubsystem::OnStarsCountUpUpdated(int32 LocalPlayerIndex)
+{
+	// Both the widget and actors read the same displayed progression, so they are always in sync
+	if (LocalPlayerIndex == 0)
+	{
+		UpdateStarActorsFills();
+	}
+
+	UPSHUDComponent* HUDComponent = GetLocalPlayerData(LocalPlayerIndex).HUDComponent;
+	if (IsValid(HUDComponent))
+	{
+		HUDComponent->UpdateProgressionStars();
+	}
+}
+
+// Scores each star actor by visibility and distance to cameras of all local players and throttles animations of low significant stars
+void UPSWorldSubsystem::UpdateStarsSignificance()
+{
+	StarActorsInternal.RemoveAll([](const TObjectPtr<APSStarActor>& StarActor) { return !IsValid(StarActor); });
+
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	FPSStarsSignificanceSettings Settings;
+	Settings.MaxSignificantStars = MaxSignificantStarsInternal;
+	Settings.SignificanceDistance = StarsSignificanceDistanceInternal;
+	Settings.ReducedTickInterval = ReducedStarsTickIntervalInternal;
+	Settings.bFreezeNotRendered = bFreezeNotRenderedStarsInternal;
+	if (!StarsSignificanceInternal.Update(*World, StarActorsInternal, Settings))
+	{
+		// Is started again once new stars are taken
+		StarsSignificanceInternal.Stop(World);
+	}
+}
+
+// Returns the transforms of all stars of the given row, is computed once and cached until row settings are changed
+const FPSStarsLayoutData& UPSWorldSubsystem::GetStarsLayout(FName RowName, int32 StarsNum)
+{
+	const FPSRowData* RowData = GetProgressionSettingsData().Find(RowName);
+	if (!RowData)
+	{
+		RowData = &FPSRowData::EmptyData;
+	}
+
+	const UPSDataAsset* DataAsset = GetPSDataAsset();
+	const FPSStarsFormationData& FormationData = DataAsset ? DataAsset->GetStarsFormation(RowName) : FPSStarsFormationData::EmptyData;
+
+	FPSStarsLayoutData& LayoutData = StarsLayoutsInternal.FindOrAdd(RowName);
+	if (LayoutData.StarTransforms.Num() != StarsNum
+		|| LayoutData.SettingsHash != FPSStarsLayout::GetLayoutHash(*RowData, FormationData, StarsNum))
+	{
+		FPSStarsLayout::ComputeLayout(*RowData, FormationData, StarsNum, LayoutData);
+	}
+	return LayoutData;
+}
+
+// Returns current spot component returns null if spot is not found
+UPSSpotComponent* UPSWorldSubsystem::GetCurrentSpot(int32 LocalPlayerIndex) const
+{
+	const APlayerCharacter* PlayerCharacter = GetLocalPlayerCharacter(LocalPlayerIndex);
+	if (!PlayerCharacter)
+	{
+		return nullptr;
+	}
+
+	const FPlayerTag& PlayerTag = PlayerCharacter->GetPlayerTag();
+	return PlayerTag.IsValid() ? FindSpotComponent(PlayerTag) : nullptr;
+}
+
+// Returns the local player whose character is on given spot, 0 if the spot is not used by any local player
+int32 UPSWorldSubsystem::GetSpotLocalPlayerIndex(const UPSSpotComponent* SpotComponent) const
+{
+	const FName* SpotRowName = SpotComponent ? RowNamesByPlayerTagInternal.Find(SpotComponent->GetMeshChecked().GetPlayerTag()) : nullptr;
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < LocalPlayersInternal.Num(); ++LocalPlayerIndex)
+	{
+		const FPSLocalPlayerData& LocalPlayerData = LocalPlayersInternal[LocalPlayerIndex];
+		if (LocalPlayerData.SpotComponent == SpotComponent
+			|| (SpotRowName && LocalPlayerData.CurrentRowName == *SpotRowName))
+		{
+			return LocalPlayerIndex;
+		}
+	}
+	return 0;
+}
+
+// Triggers when a spot is loaded
+void UPSWorldSubsystem::OnSpotComponentLoad_Implementation(UPSSpotComponent* SpotComponent, int32 LocalPlayerIndex)
+{
+	if (!ensureMsgf(SpotComponent, TEXT("ASSERT: [%i] %s:\n'SpotComponent' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	GetOrAddLocalPlayerData(LocalPlayerIndex).SpotComponent = SpotComponent;
+}
+
+// Is called from AsyncLoadGameFromSlot once Save Game is loaded, or null if it failed to load.
+void UPSWorldSubsystem::OnAsyncLoadGameFromSlotCompleted_Implementation(const FString& SlotName, int32 UserIndex, USaveGame* SaveGame)
+{
+	// The user index is the local player whose profile is loaded
+	const int32 LocalPlayerIndex = UserIndex;
+	if (bIsProgressionFailedInternal)
+	{
+		// There are no settings to apply the save with
+		GetOrAddLocalPlayerData(LocalPlayerIndex).bIsSaveLoading = false;
+		return;
+	}
+
+	if (LocalPlayerIndex == 0 && (PendingInitStagesInternal & static_cast<int32>(EPSInitStage::SaveGame)))
+	{
+		// The primary save is applied once other stages are finished, so the loading is kept in progress until then
+		PendingPrimarySaveGameInternal = SaveGame;
+		GetOrAddLocalPlayerData(LocalPlayerIndex).bIsSaveLoading = true;
+		FinishInitStage(EPSInitStage::SaveGame);
+		return;
+	}
+
+	ApplyLoadedSaveGame(SlotName, LocalPlayerIndex, SaveGame);
+}
+
+// Sets the loaded save as the profile of the local player, creates a new one if it failed to load
+void UPSWorldSubsystem::ApplyLoadedSaveGame(const FString& SlotName, int32 LocalPlayerIndex, USaveGame* SaveGame)
+{
+	FPSLocalPlayerData& LocalPlayerData = GetOrAddLocalPlayerData(LocalPlayerIndex);
+	LocalPlayerData.bIsSaveLoading = false;
+
+	// Settings are shared by all local players and loaded once per game instance
+	const TMap<FName, FPSRowData>& ProgressionSettingsData = GetProgressionSettingsData();
+	if (!ensureMsgf(!ProgressionSettingsData.IsEmpty(), TEXT("ASSERT: [%i] %s:\n'ProgressionSettingsData' is empty!"), __LINE__, *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	// Profiles are created and kept by the core module, this world only presents them
+	UPSGameInstanceSubsystem* GameInstanceSubsystem = GetGameInstanceSubsystem();
+	if (!ensureMsgf(GameInstanceSubsystem, TEXT("ASSERT: [%i] %hs:\n'GameInstanceSubsystem' is null!"), __LINE__, __FUNCTION__))
+	{
+		return;
+	}
+	UPSSaveGameData* SaveGameData = GameInstanceSubsystem->AcquireSaveGame(SlotName, SaveGame, *this, LocalPlayerIndex);
+	LocalPlayerData.SaveGameData = SaveGameData;
+
+	SetFirstElementAsCurrent(LocalPlayerIndex);
+	RebuildPresentationCache(LocalPlayerIndex);
+
+	// In network games the server owns the progression since now
+	if (UPSReplicationComponent* ReplicationComponent = LocalPlayersInternal[LocalPlayerIndex].ReplicationComponent)
+	{
+		ReplicationComponent->UploadLocalProgression(SaveGameData);
+	}
+
+	if (bIsProgressionReadyInternal)
+	{
+		// The module is already initialized by the primary player, only widgets of this player are refreshed
+		MarkProgressionDirty(EPSDirtyFlags::MenuWidget | EPSDirtyFlags::Overlay);
+	}
+}
+
+// Destroys free pooled objects of the class above the allowed amount, the rest are kept in the pool to be reused
+void UPSWorldSubsystem::TrimPool(const UClass* ObjectClass, int32 MaxPooledNum, FPSPoolUsageData& PoolUsage)
+{
+	if (!ObjectClass)
+	{
+		return;
+	}
+
+	UPoolManagerSubsystem& PoolManager = GetPoolManagerChecked();
+	int32 KeptObjectsNum = 0;
+	PoolManager.EmptyAllByPredicate([&](const UObject* PoolObject)
+	{
+		// Objects in use by other systems are never destroyed
+		if (!PoolObject || !PoolObject->IsA(ObjectClass) || !PoolManager.IsFreeObjectInPool(PoolObject))
+		{
+			return false;
+		}
+
+		if (KeptObjectsNum < MaxPooledNum)
+		{
+			++KeptObjectsNum;
+			return false;
+		}
+
+		PoolUsage.RemoveObject(PoolObject);
+		return true;
+	});
+}
+
+// Registers the star actor received from the pool to measure how many of them were reused
+void UPSWorldSubsystem::RegisterTakenStarActor(const APSStarActor& StarActor)
+{
+	if (StarActorsPoolUsageInternal.AddTakenObject(&StarActor))
+	{
+		INC_DWORD_STAT(STAT_PSStarActorsReused);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_PSStarActorsSpawned);
+	}
+}
+
+// Destroy all star actors that should not be available by other objects anymore.
 void UPSWorldSubsystem::PerformCleanUp()
 {
-	// Destroying Star Actors
+	// Return Star Actors to the pool, they are kept there to be reused on the next return to the main menu
 	if (!PoolActorHandlersInternal.IsEmpty())
 	{
-		UPoolManagerSubsystem::Get().ReturnToPoolArray(PoolActorHandlersInternal);
+		GetPoolManagerChecked().ReturnToPoolArray(PoolActorHandlersInternal);
 		PoolActorHandlersInternal.Empty();
-		UPoolManagerSubsystem::Get().EmptyPool(UPSDataAsset::Get().GetStarActorClass());
+	}
+	if (!PrewarmStarHandlesInternal.IsEmpty())
+	{
+		GetPoolManagerChecked().ReturnToPoolArray(PrewarmStarHandlesInternal);
+		PrewarmStarHandlesInternal.Empty();
 	}
 
-	ProgressionSettingsDataInternal.Empty();
-	StarDynamicProgressMaterial = nullptr;
+	// Destroy only Star Actors above allowed pool size
+	TrimPool(GetPSDataAssetChecked().GetStarActorClass(), GetPSDataAssetChecked().GetMaxPooledStarActors(), StarActorsPoolUsageInternal);
+	StarActorsInternal.Empty();
+	StopStarsCountUp();
+	StopMatchProgress();
+	FWorldDelegates::OnWorldPostActorTick.Remove(DirtyFlushHandleInternal);
+	DirtyFlushHandleInternal.Reset();
+	DirtyFlagsInternal = 0;
+	StarsSignificanceInternal.Stop(GetWorld());
+
+	StarsLayoutsInternal.Empty();
+	RowNamesByPlayerTagInternal.Empty();
+
+	// Initialization is started again by the next world
+	if (DataAssetLoadHandleInternal.IsValid())
+	{
+		DataAssetLoadHandleInternal->CancelHandle();
+		DataAssetLoadHandleInternal.Reset();
+	}
+	PendingInitStagesInternal = 0;
+	InitStageStartTimesInternal.Empty();
+	PendingPrimarySaveGameInternal = nullptr;
+	bIsProgressionReadyInternal = false;
+	bIsProgressionFailedInternal = false;
+
+	// Saves are owned by the game instance subsystem, so they are reused by the next world without loading from disk
+	LocalPlayersInternal.Empty();
+	PublishProgressionSnapshot();
 
-	// Subsystem clean up  
+	// Subsystem clean up, the data asset is reset last, so nothing above loads it again
 	UMyPrimaryDataAsset::ResetDataAsset(PSDataAssetInternal);
-	PSHUDComponentInternal = nullptr;
-	PSSpotComponentArrayInternal.Empty();
-	PSCurrentSpotComponentInternal = nullptr;
+	SpotComponentsByPlayerTagInternal.Empty();
+}
 
-	// Saves clean up 
-	if (SaveGameDataInternal)
+// Returns the save slot of the local player in this world: the base slot name with the per-world and per-player suffixes if any
+FString UPSWorldSubsystem::GetSaveSlotName(int32 LocalPlayerIndex) const
+{
+	FString SaveSlotName = UPSSaveGameData::GetSaveSlotName() + SaveSlotSuffixInternal;
+
+	// User index is not a part of the save file name on all platforms, so each local player has its own slot
+	if (LocalPlayerIndex > 0)
 	{
-		SaveGameDataInternal->ConditionalBeginDestroy();
-		SaveGameDataInternal = nullptr;
+		SaveSlotName += FString::Printf(TEXT("_Player%d"), LocalPlayerIndex);
 	}
+
+	// The first PIE instance keeps the shared slot, so the progression is the same as in the standalone game
+	const UWorld* World = GetWorld();
+	const FWorldContext* WorldContext = World && GEngine ? GEngine->GetWorldContextFromWorld(World) : nullptr;
+	const int32 PIEInstance = WorldContext ? WorldContext->PIEInstance : INDEX_NONE;
+	if (bAppendPIEInstanceToSaveSlotInternal && PIEInstance > 0)
+	{
+		SaveSlotName += FString::Printf(TEXT("_PIE%d"), PIEInstance);
+	}
+
+	return SaveSlotName;
 }
 
-// Saves the progression to the local files
-void UPSWorldSubsystem::SaveDataAsync()
+// Sets the suffix of the save slot of this world, so parallel worlds (e.g. automation) don't share the same save file
+void UPSWorldSubsystem::SetSaveSlotSuffix(const FString& NewSaveSlotSuffix)
 {
-	if (!ensureMsgf(SaveGameDataInternal, TEXT("ASSERT: [%i] %hs:\n'SaveGameDataInternal' is null!"), __LINE__, __FUNCTION__))
+	ensureMsgf(!GetCurrentSaveGameData(), TEXT("ASSERT: [%i] %hs:\n'SaveGameData' is already loaded, the suffix is applied only to next saves!"), __LINE__, __FUNCTION__);
+	SaveSlotSuffixInternal = NewSaveSlotSuffix;
+}
+
+// Saves the progression of the local player to the local files
+void UPSWorldSubsystem::SaveDataAsync(int32 LocalPlayerIndex)
+{
+	const UPSGameInstanceSubsystem* GameInstanceSubsystem = GetGameInstanceSubsystem();
+	if (!ensureMsgf(GetCurrentSaveGameData(LocalPlayerIndex), TEXT("ASSERT: [%i] %hs:\n'SaveGameData' is null!"), __LINE__, __FUNCTION__)
+		|| !ensureMsgf(GameInstanceSubsystem, TEXT("ASSERT: [%i] %hs:\n'GameInstanceSubsystem' is null!"), __LINE__, __FUNCTION__))
 	{
 		return;
 	}
 
-	UGameplayStatics::AsyncSaveGameToSlot(SaveGameDataInternal, UPSSaveGameData::GetSaveSlotName(), SaveGameDataInternal->GetSaveSlotIndex());
+	GameInstanceSubsystem->SaveGameAsync(GetSaveSlotName(LocalPlayerIndex), LocalPlayerIndex);
+
+	// Saved data is the only source of presentation, so changed rows are recomputed once here instead of on each character switch
+	UpdatePresentationCache(LocalPlayerIndex);
 }
 
-// Removes all saved data of the Progression system and creates a new empty data
-void UPSWorldSubsystem::ResetSaveGameData()
+// Queues the end-game result of the local player, results of all local players are saved at once on the next flush
+void UPSWorldSubsystem::QueueEndGameResult(int32 LocalPlayerIndex, EEndGameState EndGameState)
 {
-	const FString& SlotName = UPSSaveGameData::GetSaveSlotName();
-	const int32 UserIndex = UPSSaveGameData::GetSaveSlotIndex();
+	if (EndGameState == EEndGameState::None
+		|| !ensureMsgf(LocalPlayerIndex >= 0, TEXT("ASSERT: [%i] %hs:\n'LocalPlayerIndex' is negative!"), __LINE__, __FUNCTION__))
+	{
+		return;
+	}
+
+	GetOrAddLocalPlayerData(LocalPlayerIndex).PendingEndGameState = EndGameState;
+	MarkProgressionDirty(EPSDirtyFlags::EndGameResults);
+}
 
-	SaveGameDataInternal = Cast<UPSSaveGameData>(UGameplayUtilsLibrary::ResetSaveGameData(SaveGameDataInternal, SlotName, UserIndex));
-	checkf(SaveGameDataInternal, TEXT("ERROR: [%i] %hs:\n'SaveGameDataInternal' is null!"), __LINE__, __FUNCTION__);
+// Applies queued end-game results of all local players and saves each changed profile once
+void UPSWorldSubsystem::ApplyEndGameResults()
+{
+	// Points posted in the last frame of the match are committed too
+	ReduceMatchProgress();
 
-	// load from data table
-	const UDataTable* ProgressionDataTable = UPSDataAsset::Get().GetProgressionDataTable();
-	if (!ensureMsgf(ProgressionDataTable, TEXT("ASSERT: [%i] %s:\n'ProgressionDataTable' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < LocalPlayersInternal.Num(); ++LocalPlayerIndex)
+	{
+		FPSLocalPlayerData& LocalPlayerData = LocalPlayersInternal[LocalPlayerIndex];
+		const EEndGameState EndGameState = LocalPlayerData.PendingEndGameState;
+		LocalPlayerData.PendingEndGameState = EEndGameState::None;
+		if (!LocalPlayerData.SaveGameData)
+		{
+			continue;
+		}
+
+		// In-match progress is committed once together with the end-game reward, it's kept while the match of this player is not finished
+		const float MatchProgress = EndGameState != EEndGameState::None ? LocalPlayerData.MatchProgress : 0.f;
+		if (EndGameState != EEndGameState::None)
+		{
+			LocalPlayerData.MatchProgress = 0.f;
+		}
+
+		// In network games the reward is applied by the server and is received as replicated rows
+		if (EndGameState != EEndGameState::None && !IsServerAuthoritative(LocalPlayerIndex))
+		{
+			// Earned stars are counted up from the progression before the save
+			const float PreviousProgression = GetCurrentSaveToDiskRowByName(LocalPlayerIndex).CurrentLevelProgression;
+			LocalPlayerData.SaveGameData->AddEndGamePoints(EndGameState, MatchProgress);
+			LocalPlayerData.bHasUnsavedChanges = true;
+			PlayStarsCountUp(PreviousProgression, LocalPlayerIndex);
+		}
+
+		if (LocalPlayerData.bHasUnsavedChanges)
+		{
+			LocalPlayerData.bHasUnsavedChanges = false;
+			SaveDataAsync(LocalPlayerIndex);
+		}
+	}
+}
+
+// Sets the component that replicates the progression of the local player owning it, the server becomes the authority of this player's progression
+void UPSWorldSubsystem::SetReplicationComponent(UPSReplicationComponent* ReplicationComponent)
+{
+	if (!ensureMsgf(ReplicationComponent, TEXT("ASSERT: [%i] %hs:\n'ReplicationComponent' is null!"), __LINE__, __FUNCTION__))
 	{
 		return;
 	}
-	UMyDataTable::GetRows(*ProgressionDataTable, ProgressionSettingsDataInternal);
 
-	for (const TTuple<FName, FPSRowData>& Row : ProgressionSettingsDataInternal)
+	FPSLocalPlayerData& LocalPlayerData = GetOrAddLocalPlayerData(GetLocalPlayerIndex(ReplicationComponent));
+	LocalPlayerData.ReplicationComponent = ReplicationComponent;
+
+	if (LocalPlayerData.SaveGameData)
 	{
-		SaveGameDataInternal->SetProgressionMap(Row.Key, FPSSaveToDiskData::EmptyData);
+		// Otherwise it's uploaded once the save is loaded
+		ReplicationComponent->UploadLocalProgression(LocalPlayerData.SaveGameData);
 	}
+}
 
-	// Re-load save game object. Load game from save file or if there is no such creates a new one
-	SetFirstElementAsCurrent();
-	UpdateProgressionUI();
+// Removes the replication component from the local player it was set for, the progression is applied locally again
+void UPSWorldSubsystem::RemoveReplicationComponent(const UPSReplicationComponent* ReplicationComponent)
+{
+	for (FPSLocalPlayerData& LocalPlayerData : LocalPlayersInternal)
+	{
+		if (ReplicationComponent && LocalPlayerData.ReplicationComponent == ReplicationComponent)
+		{
+			LocalPlayerData.ReplicationComponent = nullptr;
+		}
+	}
+}
+
+// Returns true if the progression of the local player is owned by the server, so end-game results are not applied locally
+bool UPSWorldSubsystem::IsServerAuthoritative(int32 LocalPlayerIndex) const
+{
+	const UWorld* World = GetWorld();
+	return World && World->GetNetMode() != NM_Standalone
+		&& IsValid(GetLocalPlayerData(LocalPlayerIndex).ReplicationComponent);
+}
+
+// Writes the row received from the server to the save profile of the local player, it's saved on the next flush
+void UPSWorldSubsystem::ApplyReplicatedRow(int32 LocalPlayerIndex, FName RowName, const FPSSaveToDiskData& NewSaveToDiskData)
+{
+	FPSLocalPlayerData& LocalPlayerData = GetOrAddLocalPlayerData(LocalPlayerIndex);
+	UPSSaveGameData* SaveGameData = LocalPlayerData.SaveGameData;
+	if (!SaveGameData)
+	{
+		// The server is seeded only by the loaded save, so rows are not expected before it
+		return;
+	}
 
-	const APlayerCharacter* LocalCharacter = UMyBlueprintFunctionLibrary::GetLocalPlayerCharacter();
-	if (!ensureMsgf(LocalCharacter, TEXT("ASSERT: [%i] %hs:\n'SpotComponent' is null!"), __LINE__, __FUNCTION__))
+	const FPSSaveToDiskData PreviousSaveToDiskData = SaveGameData->GetSaveToDiskDataByName(RowName);
+	const bool bIsProgressChanged = PreviousSaveToDiskData.CurrentLevelProgression != NewSaveToDiskData.CurrentLevelProgression;
+	const bool bIsUnlocked = PreviousSaveToDiskData.IsLevelLocked && !NewSaveToDiskData.IsLevelLocked;
+	if (!bIsProgressChanged && PreviousSaveToDiskData.IsLevelLocked == NewSaveToDiskData.IsLevelLocked)
 	{
+		// The row is the same as the uploaded one
 		return;
 	}
-	SetCurrentRowByTag(LocalCharacter->GetPlayerTag());
+
+	SaveGameData->SetProgressionMap(RowName, NewSaveToDiskData);
+	LocalPlayerData.bHasUnsavedChanges = true;
+
+	if (bIsProgressChanged)
+	{
+		EventBusInternal.ProgressChanged.Broadcast(FPSProgressChangedEvent{RowName, PreviousSaveToDiskData.CurrentLevelProgression, NewSaveToDiskData.CurrentLevelProgression, LocalPlayerIndex});
+	}
+	if (bIsUnlocked)
+	{
+		EventBusInternal.LevelUnlocked.Broadcast(FPSLevelUnlockedEvent{RowName, LocalPlayerIndex});
+	}
+
+	if (bIsProgressChanged && RowName == LocalPlayerData.CurrentRowName)
+	{
+		PlayStarsCountUp(PreviousSaveToDiskData.CurrentLevelProgression, LocalPlayerIndex);
+	}
+
+	// Rows of the same match result are received together, so they are saved at once
+	MarkProgressionDirty(EPSDirtyFlags::EndGameResults | EPSDirtyFlags::MenuWidget | EPSDirtyFlags::Overlay | EPSDirtyFlags::Spot);
 }
 
-// Unlocks all levels of the Progression System
-void UPSWorldSubsystem::UnlockAllLevels()
+// Removes all saved data of the Progression system of all local players and creates a new empty data
+void UPSWorldSubsystem::ResetSaveGameData()
 {
-	if (!ensureMsgf(SaveGameDataInternal, TEXT("ASSERT: [%i] %s:\n'SaveGameDataInternal' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+	// Settings are never changed, so only the profiles are reset, rows of new profiles are taken from settings, so they are copied first
+	GetProgressionSettingsData();
+	UPSGameInstanceSubsystem* GameInstanceSubsystem = GetGameInstanceSubsystem();
+	if (!ensureMsgf(GameInstanceSubsystem, TEXT("ASSERT: [%i] %hs:\n'GameInstanceSubsystem' is null!"), __LINE__, __FUNCTION__))
 	{
 		return;
 	}
-	SaveGameDataInternal->UnlockAllLevels();
-	SaveDataAsync();
+
+	// The primary profile is always reset even if it was never loaded
+	const int32 LocalPlayersNum = FMath::Max(LocalPlayersInternal.Num(), 1);
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < LocalPlayersNum; ++LocalPlayerIndex)
+	{
+		FPSLocalPlayerData& LocalPlayerData = GetOrAddLocalPlayerData(LocalPlayerIndex);
+		LocalPlayerData.SaveGameData = GameInstanceSubsystem->ResetSaveGame(GetSaveSlotName(LocalPlayerIndex), *this, LocalPlayerIndex);
+
+		// Re-load save game object. Load game from save file or if there is no such creates a new one
+		SetFirstElementAsCurrent(LocalPlayerIndex);
+
+		// All rows of the new profile are changed
+		RebuildPresentationCache(LocalPlayerIndex);
+
+		if (const APlayerCharacter* LocalCharacter = GetLocalPlayerCharacter(LocalPlayerIndex))
+		{
+			SetCurrentRowByTag(LocalCharacter->GetPlayerTag(), LocalPlayerIndex);
+		}
+	}
+
+	UpdateProgressionUI();
+}
+
+// Unlocks all levels of the Progression System for all local players
+void UPSWorldSubsystem::UnlockAllLevels()
+{
+	for (int32 LocalPlayerIndex = 0; LocalPlayerIndex < LocalPlayersInternal.Num(); ++LocalPlayerIndex)
+	{
+		UPSSaveGameData* SaveGameData = GetCurrentSaveGameData(LocalPlayerIndex);
+		if (!ensureMsgf(SaveGameData, TEXT("ASSERT: [%i] %s:\n'SaveGameData' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+		{
+			continue;
+		}
+		SaveGameData->UnlockAllLevels();
+		SaveDataAsync(LocalPlayerIndex);
+	}
 	UpdateProgressionUI();
 }
 
 // Returns difficultyMultiplier
 float UPSWorldSubsystem::GetDifficultyMultiplier() const
 {
-	const TMap<EGameDifficulty, float>& DifficultyMap = UPSDataAsset::Get().GetProgressionDifficultyMultiplier();
+	const TMap<EGameDifficulty, float>& DifficultyMap = GetPSDataAssetChecked().GetProgressionDifficultyMultiplier();
 	constexpr float DefaultDifficulty = 0.f;
 	if (!ensureMsgf(!DifficultyMap.IsEmpty(), TEXT("ASSERT: [%i] %s:\n'DifficultyMap' is empty!"), __LINE__, *FString(__FUNCTION__)))
 	{
@@ -462,21 +1614,8 @@ float UPSWorldSubsystem::GetDifficultyMultiplier() const
 	return FoundDifficulty ? *FoundDifficulty : DefaultDifficulty;
 }
 
+// Is called to update the stars actors and in widgets when finish to save date in save file, the update is deferred to the flush
 void UPSWorldSubsystem::UpdateProgressionUI()
 {
-	UPSHUDComponent* PSHUDComponent = GetProgressionSystemHUDComponent();
-	if (!ensureMsgf(PSHUDComponent, TEXT("ASSERT: [%i] %hs:\n'PSHUDComponent' is null!"), __LINE__, __FUNCTION__))
-	{
-		return;
-	}
-
-	UPSSpotComponent* SpotComponent = GetCurrentSpot();
-	if (!ensureMsgf(SpotComponent, TEXT("ASSERT: [%i] %hs:\n'SpotComponent' is null!"), __LINE__, __FUNCTION__))
-	{
-		return;
-	}
-
-	SpotComponent->ChangeSpotVisibilityStatus();
-	PSHUDComponent->UpdateProgressionWidgetForPlayer();
-	UpdateProgressionStarActors();
+	MarkProgressionDirty(EPSDirtyFlags::All);
 }
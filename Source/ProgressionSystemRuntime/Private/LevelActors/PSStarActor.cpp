@@ -12,7 +12,6 @@
 #include "Engine/World.h"
 #include "GameFramework/MyGameStateBase.h"
 #include "LevelActors/PlayerCharacter.h"
-#include "Materials/MaterialInstanceDynamic.h"
 #include "MyUtilsLibraries/GameplayUtilsLibrary.h"
 #include "Subsystems/GlobalEventsSubsystem.h"
 #include "UtilityLibraries/MyBlueprintFunctionLibrary.h"
@@ -34,6 +33,12 @@ void APSStarActor::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Stars share the same material for any state, so it is set only once for the pooled actor
+	if (UMaterialInterface* StarMaterial = GetPSContext().GetDataAssetChecked().GetStarProgressionMaterial())
+	{
+		StarMeshComponent->SetMaterial(0, StarMaterial);
+	}
+
 	// Listen to hande when local character is ready 
 	BIND_ON_LOCAL_CHARACTER_READY(this, ThisClass::OnLocalCharacterReady);
 
@@ -85,6 +90,8 @@ void APSStarActor::OnGameStateChanged_Implementation(ECurrentGameState GameState
 // Is called when any cinematic started
 void APSStarActor::OnAnyCinematicStarted_Implementation(const UObject* LevelSequence, const UObject* FromInstigator)
 {
+	// Hide animation has to be finished to return the star to the pool, so it is never throttled
+	SetAnimationThrottling(0.f, false);
 	SetStartTimeHideStars();
 	TryPlayHideStarAnimation();
 }
@@ -92,19 +99,19 @@ void APSStarActor::OnAnyCinematicStarted_Implementation(const UObject* LevelSequ
 // Hiding stars with animation in main menu when cinematic is start to play
 void APSStarActor::TryPlayHideStarAnimation()
 {
-	const FPSRowData& CurrentProgressionSettingsRow = UPSWorldSubsystem::Get().GetCurrentProgressionSettingsRowByName();
+	const FPSRowData& CurrentProgressionSettingsRow = GetPSContext().GetCurrentSettingsRow();
 	const bool bIsFinished = !TryPlayStarAnimation(StartTimeHideStarsInternal, CurrentProgressionSettingsRow.HideStarsAnimation);
 	if (bIsFinished)
 	{
 		StartTimeHideStarsInternal = 0.f;
-		UPoolManagerSubsystem::Get().ReturnToPool(this);
+		GetPSContext().GetSubsystemChecked().GetPoolManagerChecked().ReturnToPool(this);
 	}
 }
 
 // Menu stars with animation in main menu idle 
 void APSStarActor::TryPlayMenuStarAnimation()
 {
-	const FPSRowData& CurrentProgressionSettingsRow = UPSWorldSubsystem::Get().GetCurrentProgressionSettingsRowByName();
+	const FPSRowData& CurrentProgressionSettingsRow = GetPSContext().GetCurrentSettingsRow();
 	const bool bIsFinished = !TryPlayStarAnimation(StartTimeMenuStarsInternal, CurrentProgressionSettingsRow.MenuStarsAnimation);
 	if (bIsFinished)
 	{
@@ -145,46 +152,54 @@ void APSStarActor::SetStartTimeMenuStars()
 }
 
 //  Is get called when a Star actor is initialized
-void APSStarActor::OnInitialized(const FVector& PreviousActorLocation)
+void APSStarActor::OnInitialized(const FTransform& StarTransform)
 {
-	const FPSRowData& CurrentProgressionSettingsRow = UPSWorldSubsystem::Get().GetCurrentProgressionSettingsRowByName();
-	FTransform DesiredTransform = CurrentProgressionSettingsRow.StarActorTransform;
+	InitialTransformInternal = StarTransform;
+	SetActorTransform(StarTransform);
 
-	// set offset from previous if it's not first
-	// if the PreviousActorTransform is empty this means it is a first element and set init transform
-	if (!PreviousActorLocation.Equals(FVector::ZeroVector))
+	// Pooled star could be throttled by the previous usage
+	SetAnimationThrottling(0.f, false);
+}
+
+// Throttles the star animations depending on the star significance
+void APSStarActor::SetAnimationThrottling(float TickInterval, bool bShouldFreeze)
+{
+	if (StartTimeHideStarsInternal)
 	{
-		DesiredTransform.SetLocation(PreviousActorLocation + CurrentProgressionSettingsRow.OffsetBetweenStarActors);
+		// Hide animation is playing, keep it at full rate
+		TickInterval = 0.f;
+		bShouldFreeze = false;
 	}
 
-	InitialTransformInternal = DesiredTransform;
-	SetActorTransform(DesiredTransform);
+	SetActorTickInterval(TickInterval);
+	SetActorTickEnabled(!bShouldFreeze);
 }
 
-//  Updates star actors Mesh material to the Locked Star, Unlocked or partially achieved
-void APSStarActor::UpdateStarActorMeshMaterial(UMaterialInstanceDynamic* StarDynamicProgressMaterial, float AmountOfStars, EPSStarActorState StarActorState)
+//  Updates star actor fill and lock values through custom primitive data of its mesh
+void APSStarActor::UpdateStarActorMeshMaterial(float AmountOfStars, EPSStarActorState StarActorState)
 {
-	if (!ensureMsgf(StarDynamicProgressMaterial, TEXT("ASSERT: [%i] %hs:\n'StarDynamicProgressMaterial' is not valid!"), __LINE__, __FUNCTION__)
-		|| !ensureMsgf(StarMeshComponent, TEXT("ASSERT: [%i] %hs:\n'StarMeshComponent' is not valid!"), __LINE__, __FUNCTION__))
+	if (!ensureMsgf(StarMeshComponent, TEXT("ASSERT: [%i] %hs:\n'StarMeshComponent' is not valid!"), __LINE__, __FUNCTION__))
 	{
 		return; // Early return if pointers are invalid
 	}
 
-	// locked stars
-	if (StarActorState == EPSStarActorState::Locked)
-	{
-		StarMeshComponent->SetMaterial(0, UPSDataAsset::Get().GetLockedProgressionMaterial());
-		return;
-	}
+	const UPSDataAsset& PSDataAsset = GetPSContext().GetDataAssetChecked();
+	const bool bIsLocked = StarActorState == EPSStarActorState::Locked;
 
-	// unlocked stars with fractional part
-	if (AmountOfStars > 0 && AmountOfStars < 1)
-	{
-		StarMeshComponent->SetMaterial(0, StarDynamicProgressMaterial);
-		StarDynamicProgressMaterial->SetScalarParameterValue(UPSDataAsset::Get().GetStarMaterialSlotName(), AmountOfStars / UPSDataAsset::Get().GetStarMaterialFractionalDivisor()); // StarMaterialFractionalDivisor is hardcoded value to 3 to tweak bad UV to simulate it's working
-		return; // Early return for fractional stars
-	}
+	// The same mapping for partial and full stars, so more points never display less fill
+	const float FillValue = bIsLocked ? 0.f : FMath::Clamp(AmountOfStars, 0.f, 1.f) / FMath::Max(PSDataAsset.GetStarMaterialFractionalDivisor(), UE_KINDA_SMALL_NUMBER);
 
-	// unlocked stars EPSStarActorState::Unlocked
-	StarMeshComponent->SetMaterial(0, UPSDataAsset::Get().GetUnlockedProgressionMaterial());
+	// Values are updated every frame while count-up is playing, so render state is marked dirty only for changed ones
+	const TArray<float>& CustomData = StarMeshComponent->GetCustomPrimitiveData().Data;
+	const auto SetCustomDataIfChanged = [this, &CustomData](int32 DataIndex, float Value)
+	{
+		if (!CustomData.IsValidIndex(DataIndex) || CustomData[DataIndex] != Value)
+		{
+			StarMeshComponent->SetCustomPrimitiveDataFloat(DataIndex, Value);
+		}
+	};
+
+	SetCustomDataIfChanged(PSDataAsset.GetStarFillPrimitiveDataIndex(), FillValue);
+	SetCustomDataIfChanged(PSDataAsset.GetStarLockPrimitiveDataIndex(), bIsLocked ? 1.f : 0.f);
 }
+
@@ -0,0 +1,250 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Widgets/PSMenuWidget.h"
+#include "Widgets/PSOverlayWidget.h"
+#include "Widgets/PSStarBarWidget.h"
+//---
+#include "Blueprint/UserWidget.h"
+#include "Debugging/SlateDebugging.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_SLATE_DEBUGGING
+
+namespace PSWidgetInvalidationTests
+{
+	/** Counts invalidations of Slate widgets of one UMG widget while it's in scope */
+	struct FInvalidationCounter
+	{
+		/** Starts counting invalidations of given widget. */
+		explicit FInvalidationCounter(const TSharedRef<SWidget>& InWidget)
+		{
+			Widgets.Emplace(&InWidget.Get());
+			DelegateHandle = FSlateDebugging::WidgetInvalidateEvent.AddRaw(this, &FInvalidationCounter::OnWidgetInvalidated);
+		}
+
+		/** Starts counting invalidations of the user widget: its padding is set on the public widget, its visibility on the cached one. */
+		FInvalidationCounter(const TSharedRef<SWidget>& InPublicWidget, const TSharedPtr<SWidget>& InCachedWidget)
+			: FInvalidationCounter(InPublicWidget)
+		{
+			if (InCachedWidget.IsValid() && InCachedWidget.Get() != &InPublicWidget.Get())
+			{
+				Widgets.Emplace(InCachedWidget.Get());
+			}
+		}
+
+		/** Stops counting. */
+		~FInvalidationCounter()
+		{
+			FSlateDebugging::WidgetInvalidateEvent.Remove(DelegateHandle);
+		}
+
+		/** Returns the amount of invalidations since the last reset and resets it. */
+		int32 Take(bool& bOutHasLayout)
+		{
+			bOutHasLayout = bHasLayout;
+			const int32 TakenNum = InvalidationsNum;
+			InvalidationsNum = 0;
+			bHasLayout = false;
+			return TakenNum;
+		}
+
+	private:
+		/** Is called by Slate on any widget invalidation. */
+		void OnWidgetInvalidated(const FSlateDebuggingInvalidateArgs& Args)
+		{
+			if (Widgets.Contains(Args.WidgetInvalidated))
+			{
+				++InvalidationsNum;
+				bHasLayout |= EnumHasAnyFlags(Args.InvalidateWidgetReason, EInvalidateWidgetReason::Layout);
+			}
+		}
+
+		TArray<const SWidget*, TInlineAllocator<2>> Widgets;
+		FDelegateHandle DelegateHandle;
+		int32 InvalidationsNum = 0;
+		bool bHasLayout = false;
+	};
+
+	/** Returns the world where the game has begun play, null if the game is not started. */
+	UWorld* FindGameWorld()
+	{
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			UWorld* World = WorldContext.World();
+			if ((WorldContext.WorldType == EWorldType::Game || WorldContext.WorldType == EWorldType::PIE)
+				&& World
+				&& World->HasBegunPlay())
+			{
+				return World;
+			}
+		}
+		return nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSStarBarInvalidationTest, "ProgressionSystem.Widgets.StarBarInvalidation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+// Checks that the star bar is invalidated once per changed progression and re-lays out only when the amount of stars is changed
+bool FPSStarBarInvalidationTest::RunTest(const FString& Parameters)
+{
+	using namespace PSWidgetInvalidationTests;
+
+	UPSStarBarWidget* StarBar = NewObject<UPSStarBarWidget>(GetTransientPackage());
+	const TSharedRef<SWidget> StarBarSlate = StarBar->TakeWidget();
+	StarBar->SetStarFills({1.f, 0.f, 0.f});
+
+	FInvalidationCounter Counter(StarBarSlate);
+	bool bHasLayout = false;
+
+	// Count-up frame: the same stars are filled more
+	StarBar->SetStarFills({1.f, 0.5f, 0.f});
+	TestEqual(TEXT("Invalidations by the count-up frame"), Counter.Take(bHasLayout), 1);
+	TestFalse(TEXT("Count-up frame invalidates the layout"), bHasLayout);
+
+	// Progression flush without changes
+	StarBar->SetStarFills({1.f, 0.5f, 0.f});
+	TestEqual(TEXT("Invalidations by the unchanged progression"), Counter.Take(bHasLayout), 0);
+
+	// Character switch to the level with another amount of stars
+	StarBar->SetStarFills({0.f, 0.f, 0.f, 0.f, 0.f});
+	TestEqual(TEXT("Invalidations by the switched level"), Counter.Take(bHasLayout), 1);
+	TestTrue(TEXT("Switched level invalidates the layout"), bHasLayout);
+
+	StarBar->ReleaseSlateResources(true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSOverlayInvalidationTest, "ProgressionSystem.Widgets.OverlayInvalidation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+// Checks that the overlay is invalidated only when the lock state of the level is changed
+bool FPSOverlayInvalidationTest::RunTest(const FString& Parameters)
+{
+	using namespace PSWidgetInvalidationTests;
+
+	UPSOverlayWidget* Overlay = NewObject<UPSOverlayWidget>(GetTransientPackage());
+	Overlay->Initialize();
+	const TSharedRef<SWidget> OverlaySlate = Overlay->TakeWidget();
+
+	FInvalidationCounter Counter(OverlaySlate);
+	bool bHasLayout = false;
+
+	// Locked level is selected
+	Overlay->SetOverlayVisibility(ESlateVisibility::Visible);
+	TestEqual(TEXT("Invalidations by locking the level"), Counter.Take(bHasLayout), 1);
+
+	// Progression flush of the same level
+	Overlay->SetOverlayVisibility(ESlateVisibility::Visible);
+	TestEqual(TEXT("Invalidations by the unchanged lock state"), Counter.Take(bHasLayout), 0);
+
+	// Unlocked level is selected
+	Overlay->SetOverlayVisibility(ESlateVisibility::Collapsed);
+	TestEqual(TEXT("Invalidations by unlocking the level"), Counter.Take(bHasLayout), 1);
+
+	// Progression flush of the same level
+	Overlay->SetOverlayVisibility(ESlateVisibility::Collapsed);
+	TestEqual(TEXT("Invalidations by the unchanged unlock state"), Counter.Take(bHasLayout), 0);
+
+	Overlay->ReleaseSlateResources(true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPSMenuWidgetInvalidationTest, "ProgressionSystem.Widgets.MenuWidgetInvalidation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+// Checks that the menu widget is invalidated only by actual changes of menu -> end-game -> menu transitions, and showing it never re-lays out the viewport
+bool FPSMenuWidgetInvalidationTest::RunTest(const FString& Parameters)
+{
+	using namespace PSWidgetInvalidationTests;
+
+	// The menu widget listens to game state events, so it's created in the game world, in the editor it's the PIE world
+	bool bIsPIEStarted = false;
+#if WITH_EDITOR
+	if (GEditor && !FindGameWorld())
+	{
+		FRequestPlaySessionParams PlaySessionParams;
+		PlaySessionParams.WorldType = EPlaySessionWorldType::PlayInEditor;
+		GEditor->RequestPlaySession(PlaySessionParams);
+		bIsPIEStarted = true;
+	}
+#endif
+
+	constexpr float GameWorldTimeout = 30.f;
+	ADD_LATENT_AUTOMATION_COMMAND(FUntilCommand([] { return FindGameWorld() != nullptr; }, [this]
+	{
+		AddError(TEXT("Timeout: the game world is not started"));
+		return true;
+	}, GameWorldTimeout));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, bIsPIEStarted]
+	{
+		UWorld* World = FindGameWorld();
+		UPSMenuWidget* MenuWidget = World ? CreateWidget<UPSMenuWidget>(World, UPSMenuWidget::StaticClass()) : nullptr;
+		if (!MenuWidget)
+		{
+			return true;
+		}
+
+		// The widget is constructed hidden in the main menu position
+		const TSharedRef<SWidget> MenuSlate = MenuWidget->TakeWidget();
+		FInvalidationCounter Counter(MenuSlate, MenuWidget->GetCachedWidget());
+		bool bHasLayout = false;
+
+		// The presentation of the same row is applied by each progression flush
+		FPSPresentationData PresentationData;
+		PresentationData.PointsToUnlock = 3.f;
+		MenuWidget->ApplyPresentationData(PresentationData);
+		Counter.Take(bHasLayout);
+
+		// Menu -> end-game: the widget is shown and moved to the end-game position
+		MenuWidget->SetMenuWidgetShown(true);
+		TestEqual(TEXT("Invalidations by showing the widget"), Counter.Take(bHasLayout), 1);
+		TestFalse(TEXT("Showing the widget invalidates the layout"), bHasLayout);
+
+		MenuWidget->SetEndGamePosition(true);
+		TestEqual(TEXT("Invalidations by moving to the end-game position"), Counter.Take(bHasLayout), 1);
+		TestTrue(TEXT("Moving to the end-game position invalidates the layout"), bHasLayout);
+
+		// End-game screen: the same state is requested again by each end-game event and flush
+		MenuWidget->SetMenuWidgetShown(true);
+		MenuWidget->SetEndGamePosition(true);
+		MenuWidget->ApplyPresentationData(PresentationData);
+		TestEqual(TEXT("Invalidations by the unchanged end-game screen"), Counter.Take(bHasLayout), 0);
+
+		// End-game -> menu: the widget is moved back and hidden
+		MenuWidget->SetEndGamePosition(false);
+		TestEqual(TEXT("Invalidations by moving to the menu position"), Counter.Take(bHasLayout), 1);
+		TestTrue(TEXT("Moving to the menu position invalidates the layout"), bHasLayout);
+
+		MenuWidget->SetMenuWidgetShown(false);
+		TestEqual(TEXT("Invalidations by hiding the widget"), Counter.Take(bHasLayout), 1);
+		TestFalse(TEXT("Hiding the widget invalidates the layout"), bHasLayout);
+
+		// Menu: the same state is requested again by the next game state change
+		MenuWidget->SetMenuWidgetShown(false);
+		MenuWidget->SetEndGamePosition(false);
+		MenuWidget->ApplyPresentationData(PresentationData);
+		TestEqual(TEXT("Invalidations by the unchanged menu"), Counter.Take(bHasLayout), 0);
+
+		MenuWidget->ReleaseSlateResources(true);
+
+		if (bIsPIEStarted)
+		{
+#if WITH_EDITOR
+			GEditor->RequestEndPlayMap();
+#endif
+		}
+		return true;
+	}));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_SLATE_DEBUGGING
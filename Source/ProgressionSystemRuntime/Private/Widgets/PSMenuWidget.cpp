@@ -3,8 +3,11 @@
 #include "Widgets/PSMenuWidget.h"
 //---
 #include "Data/PSDataAsset.h"
+#include "Data/PSWorldSubsystem.h"
 #include "Components/HorizontalBox.h"
 #include "Components/Image.h"
+#include "Components/TextBlock.h"
+#include "Widgets/PSStarBarWidget.h"
 #include "Widgets/PSStarWidget.h"
 //---
 
@@ -25,7 +28,14 @@ void UPSMenuWidget::NativeConstruct()
 	Super::NativeConstruct();
 
 	// Hide this widget by default
-	SetVisibility(ESlateVisibility::Collapsed);
+	SetMenuWidgetShown(false);
+
+	if (StarBar)
+	{
+		// Use star icons atlas brushes unless the designer set own brushes
+		const UPSDataAsset& PSDataAsset = GetPSContext().GetDataAssetChecked();
+		StarBar->SetDefaultStarBrushes(PSDataAsset.GetLockedStarBrush(), PSDataAsset.GetUnlockedStarBrush());
+	}
 
 	// Listen to handle input for each game state
 	BIND_ON_GAME_STATE_CHANGED(this, ThisClass::OnGameStateChanged);
@@ -40,7 +50,7 @@ void UPSMenuWidget::OnGameStateChanged_Implementation(ECurrentGameState CurrentG
 	switch (CurrentGameState)
 	{
 	case ECurrentGameState::GameStarting:
-		SetVisibility(ESlateVisibility::Collapsed);
+		SetMenuWidgetShown(false);
 		break;
 	default: break;
 	}
@@ -60,102 +70,265 @@ void UPSMenuWidget::OnEndGameStateChanged_Implementation(EEndGameState EndGameSt
 	if (EndGameState != EEndGameState::None)
 	{
 		// show the stars widget at the bottom.
-		SetVisibility(ESlateVisibility::Visible);
-		SetPadding(FMargin(0, 800, 0, 0)); // @todo h4rdmol gafWu8QJ PSMenuWidget Expose margin to a variable for the designer
+		SetMenuWidgetShown(true);
+		SetEndGamePosition(true);
+	}
+}
+
+// Shows or hides the widget, is hidden instead of collapsed since it's the root widget in the viewport
+void UPSMenuWidget::SetMenuWidgetShown(bool bIsShown)
+{
+	// Progression bar is not interactive, so it's not hit-testable to stay out of the hit test grid
+	SetVisibility(bIsShown ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Hidden);
+}
+
+// Moves the widget to its end-game or main menu position by the padding
+void UPSMenuWidget::SetEndGamePosition(bool bIsEndGame)
+{
+	// Padding changes the layout of the content, so it's set only when the position is changed
+	const FMargin NewPadding = bIsEndGame ? EndGamePaddingInternal : FMargin(0.f);
+	if (GetPadding() != NewPadding)
+	{
+		SetPadding(NewPadding);
 	}
 }
 
 // Dynamically populates a Horizontal Box with images representing unlocked and locked progression icons.
 void UPSMenuWidget::AddImagesToHorizontalBox(float AmountOfUnlockedPoints, float AmountOfLockedPoints, float MaxLevelPoints)
 {
-	//Return to Pool Manager the list of handles which is not needed (if there are any) 
+	// Convert points into displayed stars, so the amount of widgets is bounded by the display cap, not by the level design values
+	const float DisplayScale = GetPSContext().GetDataAssetChecked().GetStarsDisplayScale(MaxLevelPoints);
+	UpdateStarsCounter(AmountOfUnlockedPoints, MaxLevelPoints, DisplayScale < 1.f);
+	AmountOfUnlockedPoints *= DisplayScale;
+	AmountOfLockedPoints *= DisplayScale;
+	MaxLevelPoints *= DisplayScale;
 
-	if (!PoolWidgetHandlersInternal.IsEmpty())
+	// Each star is filled by the amount of unlocked points it covers, 0 is the locked star
+	const int32 StarsNum = FMath::RoundToInt(AmountOfLockedPoints + AmountOfUnlockedPoints);
+	TArray<float> NewStarFills;
+	NewStarFills.SetNumUninitialized(FMath::Max(StarsNum, 0));
+	for (int32 Index = 0; Index < NewStarFills.Num(); ++Index)
 	{
-		UPoolManagerSubsystem::Get().ReturnToPoolArray(PoolWidgetHandlersInternal);
-		PoolWidgetHandlersInternal.Empty();
+		NewStarFills[Index] = FMath::Clamp(AmountOfUnlockedPoints - Index, 0.f, 1.f);
 	}
 
-	// --- Prepare spawn request
-	const TWeakObjectPtr<ThisClass> WeakThis = this;
-	const FOnSpawnAllCallback OnTakeFromPoolCompleted = [WeakThis, AmountOfUnlockedPoints, AmountOfLockedPoints, MaxLevelPoints](const TArray<FPoolObjectData>& CreatedObjects)
+	SetDesiredStarFills(NewStarFills);
+}
+
+// Displays the precomputed presentation of the progression row: star fills and the counter
+void UPSMenuWidget::ApplyPresentationData(const FPSPresentationData& PresentationData)
+{
+	UpdateStarsCounter(PresentationData.LevelProgression, PresentationData.PointsToUnlock, PresentationData.bIsCompacted);
+	SetDesiredStarFills(PresentationData.StarFills);
+}
+
+// Sets the fills that should be displayed, requests only missing star widgets and applies the differences
+void UPSMenuWidget::SetDesiredStarFills(const TArray<float>& NewStarFills)
+{
+	if (NewStarFills == DesiredStarFillsInternal)
 	{
-		if (UPSMenuWidget* This = WeakThis.Get())
-		{
-			This->OnTakeFromPoolCompleted(CreatedObjects, AmountOfUnlockedPoints, AmountOfLockedPoints, MaxLevelPoints);
-		}
-	};
+		// Nothing changed, keep the widgets as they are
+		return;
+	}
+	DesiredStarFillsInternal = NewStarFills;
+	const int32 StarsNum = DesiredStarFillsInternal.Num();
 
-	// --- Spawn widgets
-	const int32 TotalRequests = AmountOfLockedPoints + AmountOfUnlockedPoints;
-	if (TotalRequests == 0)
+	if (StarBar)
 	{
-		// no items to request nothing to add
+		// All stars are painted by the single native widget, no star widgets are needed
+		StarBar->SetStarFills(DesiredStarFillsInternal);
 		return;
 	}
-	UPoolManagerSubsystem::Get().TakeFromPoolArray(PoolWidgetHandlersInternal, UPSDataAsset::Get().GetStarWidgetClass(), TotalRequests, OnTakeFromPoolCompleted);
+
+	// --- Request only missing widgets, the surplus ones are returned in ApplyStarFills
+	const int32 MissingWidgetsNum = StarsNum - StarWidgetsInternal.Num() - PendingStarWidgetsNumInternal;
+	if (MissingWidgetsNum > 0)
+	{
+		const TWeakObjectPtr<ThisClass> WeakThis = this;
+		const FOnSpawnAllCallback OnTakeFromPoolCompleted = [WeakThis](const TArray<FPoolObjectData>& CreatedObjects)
+		{
+			if (UPSMenuWidget* This = WeakThis.Get())
+			{
+				This->OnTakeStarWidgetsCompleted(CreatedObjects);
+			}
+		};
+
+		PendingStarWidgetsNumInternal += MissingWidgetsNum;
+		TArray<FPoolObjectHandle> RequestedHandles;
+		GetPSContext().GetSubsystemChecked().GetPoolManagerChecked().TakeFromPoolArray(RequestedHandles, GetPSContext().GetDataAssetChecked().GetStarWidgetClass(), MissingWidgetsNum, OnTakeFromPoolCompleted);
+		PoolWidgetHandlersInternal.Append(RequestedHandles);
+	}
+
+	ApplyStarFills();
 }
 
-// Dynamically populates a Horizontal Box with images representing unlocked and locked progression icons
-void UPSMenuWidget::OnTakeFromPoolCompleted(const TArray<FPoolObjectData>& CreatedObjects, float AmountOfUnlockedPoints, float AmountOfLockedPoints, float MaxLevelPoints)
+// Returns all star widgets to the pool, the pool is kept to be reused by the next menu widget unless it grew above allowed size
+void UPSMenuWidget::ReleaseStarWidgets()
+{
+	if (HorizontalBox)
+	{
+		HorizontalBox->ClearChildren();
+	}
+
+	if (!PoolWidgetHandlersInternal.IsEmpty())
+	{
+		GetPSContext().GetSubsystemChecked().GetPoolManagerChecked().ReturnToPoolArray(PoolWidgetHandlersInternal);
+		PoolWidgetHandlersInternal.Empty();
+	}
+	StarWidgetsInternal.Empty();
+	StarWidgetHandlesInternal.Empty();
+	DisplayedStarFillsInternal.Empty();
+	DesiredStarFillsInternal.Empty();
+	PendingStarWidgetsNumInternal = 0;
+
+	// Destroy only star widgets above allowed pool size
+	UPSWorldSubsystem& WorldSubsystem = GetPSContext().GetSubsystemChecked();
+	const UPSDataAsset& PSDataAsset = GetPSContext().GetDataAssetChecked();
+	WorldSubsystem.TrimPool(PSDataAsset.GetStarWidgetClass(), PSDataAsset.GetMaxPooledStarWidgets(), WorldSubsystem.GetStarWidgetsPoolUsage());
+}
+
+// Is called when requested star widgets are taken from the pool, appends them to the Horizontal Box and applies desired fills
+void UPSMenuWidget::OnTakeStarWidgetsCompleted(const TArray<FPoolObjectData>& CreatedObjects)
 {
 	if (!ensureMsgf(HorizontalBox, TEXT("ASSERT: [%i] %hs:\n'HorizontalBox' is null!"), __LINE__, __FUNCTION__))
 	{
 		return;
 	}
-	HorizontalBox->ClearChildren();
-	float CurrentAmountOfUnlocked = AmountOfUnlockedPoints;
-	float CurrentAmountOfLocked = AmountOfLockedPoints;
-	// Setup spawned widget
+
+	FPSPoolUsageData& StarWidgetsPoolUsage = GetPSContext().GetSubsystemChecked().GetStarWidgetsPoolUsage();
 	for (const FPoolObjectData& CreatedObject : CreatedObjects)
 	{
-		if (CurrentAmountOfUnlocked > 0)
+		// Measure by the objects actually received from the pool
+		if (StarWidgetsPoolUsage.AddTakenObject(&CreatedObject.GetChecked<UPSStarWidget>()))
 		{
-			// #1 Create MyFunction
-			UpdateStarImages(CreatedObject, 1, 0);
-			// more than 0 means that it's not an integer
-			if ((MaxLevelPoints - CurrentAmountOfUnlocked) > 0)
-			{
-				UpdateStarProgressBarValue(CreatedObject, CurrentAmountOfUnlocked);
-			}
-			CurrentAmountOfUnlocked--;
+			INC_DWORD_STAT(STAT_PSStarWidgetsReused);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_PSStarWidgetsSpawned);
+		}
+
+		if (!PoolWidgetHandlersInternal.Contains(CreatedObject.Handle))
+		{
+			// Widgets were released while the request was in progress
 			continue;
 		}
 
-		if (CurrentAmountOfLocked > 0)
+		UPSStarWidget& SpawnedWidget = CreatedObject.GetChecked<UPSStarWidget>();
+		StarWidgetsInternal.Emplace(&SpawnedWidget);
+		StarWidgetHandlesInternal.Emplace(CreatedObject.Handle);
+		DisplayedStarFillsInternal.Emplace(INDEX_NONE); // unknown fill, will be applied below
+		HorizontalBox->AddChildToHorizontalBox(&SpawnedWidget);
+		PendingStarWidgetsNumInternal = FMath::Max(PendingStarWidgetsNumInternal - 1, 0);
+	}
+
+	ApplyStarFills();
+}
+
+// Dynamically populates a Horizontal Box with images representing unlocked and locked progression icons, is kept for existing callers
+void UPSMenuWidget::OnTakeFromPoolCompleted(const TArray<FPoolObjectData>& CreatedObjects, float AmountOfUnlockedPoints, float AmountOfLockedPoints, float MaxLevelPoints)
+{
+	// Widgets were taken by the caller, so they are adopted to be diffed and returned to the pool as own ones
+	TArray<FPoolObjectData> AdoptedObjects;
+	AdoptedObjects.Reserve(CreatedObjects.Num());
+	for (const FPoolObjectData& CreatedObject : CreatedObjects)
+	{
+		if (CreatedObject.IsValid()
+			&& !StarWidgetHandlesInternal.Contains(CreatedObject.Handle))
 		{
-			UpdateStarImages(CreatedObject, 0, 1);
-			CurrentAmountOfLocked--;
+			PoolWidgetHandlersInternal.AddUnique(CreatedObject.Handle);
+			AdoptedObjects.Emplace(CreatedObject);
 		}
 	}
+
+	// Own requests that are still in progress are not affected by adopted widgets
+	const int32 PendingStarWidgetsNum = PendingStarWidgetsNumInternal;
+	OnTakeStarWidgetsCompleted(AdoptedObjects);
+	PendingStarWidgetsNumInternal = PendingStarWidgetsNum;
+
+	AddImagesToHorizontalBox(AmountOfUnlockedPoints, AmountOfLockedPoints, MaxLevelPoints);
 }
 
-// Updates star images icon to locked/unlocked according to input amounnt
-void UPSMenuWidget::UpdateStarImages(const FPoolObjectData& CreatedData, float AmountOfUnlockedStars, float AmountOfLockedStars)
+// Applies only the differences between desired and displayed star fills
+void UPSMenuWidget::ApplyStarFills()
 {
-	UPSStarWidget& SpawnedWidget = CreatedData.GetChecked<UPSStarWidget>();
+	// --- Return surplus widgets, the last ones are removed to keep the order of the rest
+	const int32 SurplusNum = StarWidgetsInternal.Num() - DesiredStarFillsInternal.Num();
+	if (SurplusNum > 0)
+	{
+		const int32 FirstSurplusIndex = DesiredStarFillsInternal.Num();
+		TArray<FPoolObjectHandle> SurplusHandles;
+		SurplusHandles.Reserve(SurplusNum);
+		for (int32 Index = FirstSurplusIndex; Index < StarWidgetsInternal.Num(); ++Index)
+		{
+			if (HorizontalBox)
+			{
+				HorizontalBox->RemoveChild(StarWidgetsInternal[Index]);
+			}
+			SurplusHandles.Emplace(StarWidgetHandlesInternal[Index]);
+			PoolWidgetHandlersInternal.RemoveSingleSwap(StarWidgetHandlesInternal[Index]);
+		}
+		GetPSContext().GetSubsystemChecked().GetPoolManagerChecked().ReturnToPoolArray(SurplusHandles);
+
+		StarWidgetsInternal.SetNum(FirstSurplusIndex);
+		StarWidgetHandlesInternal.SetNum(FirstSurplusIndex);
+		DisplayedStarFillsInternal.SetNum(FirstSurplusIndex);
+	}
 
-	if (AmountOfUnlockedStars > 0)
+	// --- Update only changed stars
+	for (int32 Index = 0; Index < StarWidgetsInternal.Num(); ++Index)
 	{
-		SpawnedWidget.SetStarImage(UPSDataAsset::Get().GetUnlockedProgressionIcon());
-		SpawnedWidget.UpdateProgressionBarPercentage(AmountOfUnlockedStars);
+		const float NewFill = DesiredStarFillsInternal[Index];
+		float& DisplayedFill = DisplayedStarFillsInternal[Index];
+		if (DisplayedFill != NewFill)
+		{
+			UpdateStarWidget(StarWidgetsInternal[Index], DisplayedFill, NewFill);
+			DisplayedFill = NewFill;
+		}
 	}
+}
 
-	if (AmountOfLockedStars > 0)
+// Updates star image icon to locked/unlocked and progress bar percentage
+void UPSMenuWidget::UpdateStarWidget(UPSStarWidget* StarWidget, float PreviousFill, float NewFill)
+{
+	if (!ensureMsgf(StarWidget, TEXT("ASSERT: [%i] %hs:\n'StarWidget' is null!"), __LINE__, __FUNCTION__))
 	{
-		SpawnedWidget.SetStarImage(UPSDataAsset::Get().GetLockedProgressionIcon());
+		return;
 	}
-	// Load and set the image texture here using ImagePath or other methods
-	if (!HorizontalBox->HasChild(&SpawnedWidget))
+
+	// Brush is changed only when the star is switched between locked and unlocked
+	const UPSDataAsset& PSDataAsset = GetPSContext().GetDataAssetChecked();
+	const bool bIsUnlocked = NewFill > 0.f;
+	const bool bWasUnlocked = PreviousFill > 0.f;
+	if (PreviousFill < 0.f || bIsUnlocked != bWasUnlocked)
 	{
-		HorizontalBox->AddChildToHorizontalBox(&SpawnedWidget);
-		SpawnedWidget.UpdateProgressionBarPercentage(AmountOfUnlockedStars);
+		StarWidget->SetStarBrush(bIsUnlocked ? PSDataAsset.GetUnlockedStarBrush() : PSDataAsset.GetLockedStarBrush());
 	}
+
+	StarWidget->SetStarFill(NewFill, PSDataAsset.GetUnlockedStarBrush());
 }
 
-// Updates Progress bar icon for unlocked icons 
-void UPSMenuWidget::UpdateStarProgressBarValue(const FPoolObjectData& CreatedData, float NewProgressBarValue)
+// Shows the progression counter if the stars are compacted, otherwise hides it
+void UPSMenuWidget::UpdateStarsCounter(float AmountOfUnlockedPoints, float MaxLevelPoints, bool bIsCompacted)
 {
-	UPSStarWidget& SpawnedWidget = CreatedData.GetChecked<UPSStarWidget>();
-	SpawnedWidget.UpdateProgressionBarPercentage(NewProgressBarValue);
+	if (!StarsCounterText)
+	{
+		// Counter is optional for the widget
+		return;
+	}
+
+	if (!bIsCompacted)
+	{
+		// Collapsed since the counter is laid out next to the stars, so they take its space while it's not needed
+		StarsCounterText->SetVisibility(ESlateVisibility::Collapsed);
+		return;
+	}
+
+	const FText CounterText = FText::Format(FText::FromString(TEXT("{0}/{1}")), FText::AsNumber(FMath::FloorToInt(AmountOfUnlockedPoints)), FText::AsNumber(FMath::CeilToInt(MaxLevelPoints)));
+	if (!StarsCounterText->GetText().EqualTo(CounterText))
+	{
+		StarsCounterText->SetText(CounterText);
+	}
+	StarsCounterText->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
 }
+
@@ -21,10 +21,13 @@ void UPSOverlayWidget::SetOverlayVisibility(ESlateVisibility VisibilitySlate, bo
 			PSCOverlay->SetRenderOpacity(1.0f);
 		}
 		SetOverlayItemsVisibility(VisibilitySlate);
+		bShouldPlayFadeAnimationInternal = false;
+		UnregisterFadeActiveTimer();
 		return;
 	}
 
 	bShouldPlayFadeAnimationInternal = bShouldPlayFadeAnimation;
+	FadeDurationInternal = GetPSContext().GetDataAssetChecked().GetOverlayFadeDuration();
 
 	if (VisibilitySlate == ESlateVisibility::Visible)
 	{
@@ -56,42 +59,44 @@ void UPSOverlayWidget::SetOverlayVisibility(ESlateVisibility VisibilitySlate, bo
 	}
 
 	StartTimeFadeAnimationInternal = World->GetTimeSeconds();
-}
 
-// overrides NativeTick to make the user widget tickable
-void UPSOverlayWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
-{
-	Super::NativeTick(MyGeometry, InDeltaTime);
-	if (GetVisibility() != ESlateVisibility::Visible)
+	if (bShouldPlayFadeAnimationInternal)
 	{
-		return;
+		RegisterFadeActiveTimer();
 	}
-
-	TickPlayFadeOverlayAnimation();
 }
 
 // Event to execute when widget is ready
 void UPSOverlayWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
-	SetVisibility(ESlateVisibility::Collapsed);
+	SetOverlayItemsVisibility(ESlateVisibility::Collapsed);
+}
+
+// Is called when the widget is removed from the hierarchy, stops the fade animation if any
+void UPSOverlayWidget::NativeDestruct()
+{
+	UnregisterFadeActiveTimer();
+
+	Super::NativeDestruct();
 }
 
-// Play the overlay elements fade-in/fade-out animation. Uses the internal FadeCurveFloatInternal initialized in NativeConstruct
-void UPSOverlayWidget::TickPlayFadeOverlayAnimation()
+// Play the overlay elements fade-in/fade-out animation
+bool UPSOverlayWidget::TickPlayFadeOverlayAnimation()
 {
 	const UWorld* World = GetWorld();
-	const float FadeDuration = UPSDataAsset::Get().GetOverlayFadeDuration();
+	const float FadeDuration = FadeDurationInternal;
 
 	if (!bShouldPlayFadeAnimationInternal
 		|| !World
 		|| !ensureMsgf(FadeDuration > 0.0f, TEXT("ASSERT: [%i] %hs:\n'FadeDuration' must be greater than 0"), __LINE__, __FUNCTION__))
 	{
-		return;
+		bShouldPlayFadeAnimationInternal = false;
+		return false;
 	}
 
 	const bool bIsFadeOutAnimation = OverlayWidgetFadeStateInternal == EPSOverlayWidgetFadeState::FadeOut;
-	const float SecondsSinceStart = GetWorld()->GetTimeSeconds() - StartTimeFadeAnimationInternal;
+	const float SecondsSinceStart = World->GetTimeSeconds() - StartTimeFadeAnimationInternal;
 	const float NormalizedTime = FMath::Clamp(SecondsSinceStart / FadeDuration, 0.0f, 1.0f);
 	const float OpacityValue = bIsFadeOutAnimation ? 1.0f - NormalizedTime : NormalizedTime;
 
@@ -100,15 +105,53 @@ void UPSOverlayWidget::TickPlayFadeOverlayAnimation()
 		bShouldPlayFadeAnimationInternal = false;
 		if (OverlayWidgetFadeStateInternal == EPSOverlayWidgetFadeState::FadeOut)
 		{
-			SetVisibility(ESlateVisibility::Collapsed);
+			SetOverlayItemsVisibility(ESlateVisibility::Collapsed);
 		}
-		return;
+		return false;
 	}
 
 	if (PSCOverlay)
 	{
 		PSCOverlay->SetRenderOpacity(OpacityValue);
 	}
+	return true;
+}
+
+// Registers the Slate active timer that plays the fade animation, does nothing if it's already registered
+void UPSOverlayWidget::RegisterFadeActiveTimer()
+{
+	const TSharedPtr<SWidget> CachedWidget = GetCachedWidget();
+	if (FadeActiveTimerHandleInternal.IsValid() || !CachedWidget)
+	{
+		return;
+	}
+
+	FadeActiveTimerHandleInternal = CachedWidget->RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateUObject(this, &ThisClass::OnFadeActiveTimer));
+}
+
+// Unregisters the Slate active timer of the fade animation if it's registered
+void UPSOverlayWidget::UnregisterFadeActiveTimer()
+{
+	const TSharedPtr<FActiveTimerHandle> ActiveTimerHandle = FadeActiveTimerHandleInternal.Pin();
+	const TSharedPtr<SWidget> CachedWidget = GetCachedWidget();
+	if (ActiveTimerHandle && CachedWidget)
+	{
+		CachedWidget->UnRegisterActiveTimer(ActiveTimerHandle.ToSharedRef());
+	}
+	FadeActiveTimerHandleInternal.Reset();
+}
+
+// Is called by Slate every frame while the fade animation is in progress
+EActiveTimerReturnType UPSOverlayWidget::OnFadeActiveTimer(double InCurrentTime, float InDeltaTime)
+{
+	if (TickPlayFadeOverlayAnimation())
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	// Animation is finished, the widget stops ticking until the next fade
+	FadeActiveTimerHandleInternal.Reset();
+	return EActiveTimerReturnType::Stop;
 }
 
 void UPSOverlayWidget::SetOverlayItemsVisibility(ESlateVisibility VisibilitySlate)
@@ -116,3 +159,4 @@ void UPSOverlayWidget::SetOverlayItemsVisibility(ESlateVisibility VisibilitySlat
 	// Level is unlocked hide the blocking overlay
 	SetVisibility(VisibilitySlate);
 }
+
@@ -0,0 +1,79 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Widgets/PSStarBarWidget.h"
+//---
+#include "Engine/Texture2D.h"
+#include "Widgets/SPSStarBar.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PSStarBarWidget)
+
+#define LOCTEXT_NAMESPACE "UPSStarBarWidget"
+
+// Sets the fill of each star, 0 is the locked star and 1 is the fully unlocked star
+void UPSStarBarWidget::SetStarFills(const TArray<float>& NewStarFills)
+{
+	StarFillsInternal = NewStarFills;
+
+	if (StarBarSlateInternal)
+	{
+		StarBarSlateInternal->SetStarFills(StarFillsInternal);
+	}
+}
+
+// Sets the star brushes to the ones which have no resource set by designer
+void UPSStarBarWidget::SetDefaultStarBrushes(const FSlateBrush& EmptyStarBrush, const FSlateBrush& FullStarBrush)
+{
+	// Whole brushes are copied to keep the atlas UV regions, the star size is still defined by this widget
+	if (!EmptyStarBrushInternal.GetResourceObject())
+	{
+		EmptyStarBrushInternal = EmptyStarBrush;
+	}
+
+	if (!FullStarBrushInternal.GetResourceObject())
+	{
+		FullStarBrushInternal = FullStarBrush;
+	}
+}
+
+// Applies properties to the native widget
+void UPSStarBarWidget::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+
+	if (StarBarSlateInternal)
+	{
+		StarBarSlateInternal->SetStarBrushes(&EmptyStarBrushInternal, &FullStarBrushInternal);
+		StarBarSlateInternal->SetStarLayout(StarSizeInternal, StarSpacingInternal);
+		StarBarSlateInternal->SetStarFills(StarFillsInternal);
+	}
+}
+
+// Releases the native widget
+void UPSStarBarWidget::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	StarBarSlateInternal.Reset();
+}
+
+#if WITH_EDITOR
+// Returns the category of this widget in the UMG palette
+const FText UPSStarBarWidget::GetPaletteCategory()
+{
+	return LOCTEXT("ProgressionSystem", "Progression System");
+}
+#endif
+
+// Creates the native widget
+TSharedRef<SWidget> UPSStarBarWidget::RebuildWidget()
+{
+	StarBarSlateInternal = SNew(SPSStarBar)
+		.EmptyStarBrush(&EmptyStarBrushInternal)
+		.FullStarBrush(&FullStarBrushInternal)
+		.StarSize(StarSizeInternal)
+		.StarSpacing(StarSpacingInternal);
+
+	return StarBarSlateInternal.ToSharedRef();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -13,13 +13,49 @@
 // Updates the image used for the star display
 void UPSStarWidget::SetStarImage(UTexture2D* Image)
 {
-	if (ensureMsgf(Image, TEXT("ASSERT: [%i] %s:\n'Image' is not valid!"), __LINE__, *FString(__FUNCTION__)))
+	if (ensureMsgf(Image, TEXT("ASSERT: [%i] %s:\n'Image' is not valid!"), __LINE__, *FString(__FUNCTION__))
+		&& StarImageInternal->GetBrush().GetResourceObject() != Image)
 	{
+		// Brush is set only when the texture is changed to not invalidate the widget for nothing
 		StarImageInternal->SetBrushFromTexture(Image);
 	}
 }
 
+// Updates the brush used for the star display
+void UPSStarWidget::SetStarBrush(const FSlateBrush& Brush)
+{
+	// Image compares brushes itself, so switching between atlas regions doesn't invalidate the widget if nothing changed
+	StarImageInternal->SetBrush(Brush);
+}
+
 void UPSStarWidget::UpdateProgressionBarPercentage(float NewProgressValue)
 {
-	StarProgressBarInternal->SetPercent(NewProgressValue);
+	if (StarProgressBarInternal)
+	{
+		StarProgressBarInternal->SetPercent(NewProgressValue);
+	}
+}
+
+// Fills the star by the full star brush clipped to the fill
+void UPSStarWidget::SetStarFill(float NewFill, const FSlateBrush& FullStarBrush)
+{
+	if (!StarFillImage)
+	{
+		// Widgets designed before the fill image are filled by the progress bar
+		UpdateProgressionBarPercentage(NewFill);
+		return;
+	}
+
+	// Both the UV region and the size are clipped, so the filled part is not stretched
+	const float Fill = FMath::Clamp(NewFill, 0.f, 1.f);
+	const FBox2f FullUVRegion = FullStarBrush.GetUVRegion().bIsValid ? FullStarBrush.GetUVRegion() : FBox2f(FVector2f::ZeroVector, FVector2f::UnitVector);
+	FBox2f FilledUVRegion = FullUVRegion;
+	FilledUVRegion.Max.X = FMath::Lerp(FullUVRegion.Min.X, FullUVRegion.Max.X, Fill);
+
+	FSlateBrush FilledBrush = FullStarBrush;
+	FilledBrush.SetUVRegion(FilledUVRegion);
+	FilledBrush.SetImageSize(FVector2D(FullStarBrush.GetImageSize().X * Fill, FullStarBrush.GetImageSize().Y));
+
+	// Image compares brushes itself, so the widget is not invalidated if the fill is the same
+	StarFillImage->SetBrush(FilledBrush);
 }
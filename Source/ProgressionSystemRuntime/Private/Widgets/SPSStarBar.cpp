@@ -0,0 +1,99 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#include "Widgets/SPSStarBar.h"
+//---
+#include "Rendering/DrawElements.h"
+
+// Constructs this widget with InArgs
+void SPSStarBar::Construct(const FArguments& InArgs)
+{
+	EmptyStarBrush = InArgs._EmptyStarBrush;
+	FullStarBrush = InArgs._FullStarBrush;
+	StarSize = InArgs._StarSize;
+	StarSpacing = InArgs._StarSpacing;
+}
+
+// Sets the fill of each star, 0 is the empty star and 1 is the full star
+void SPSStarBar::SetStarFills(TConstArrayView<float> NewStarFills)
+{
+	const bool bIsStarsNumChanged = StarFills.Num() != NewStarFills.Num();
+	if (!bIsStarsNumChanged && FMemory::Memcmp(StarFills.GetData(), NewStarFills.GetData(), NewStarFills.Num() * sizeof(float)) == 0)
+	{
+		return;
+	}
+
+	// Reset keeps the allocation, so updating fills of the same amount of stars does not allocate
+	StarFills.Reset(NewStarFills.Num());
+	StarFills.Append(NewStarFills.GetData(), NewStarFills.Num());
+	Invalidate(bIsStarsNumChanged ? EInvalidateWidgetReason::Layout : EInvalidateWidgetReason::Paint);
+}
+
+// Sets the brushes of the stars
+void SPSStarBar::SetStarBrushes(const FSlateBrush* NewEmptyStarBrush, const FSlateBrush* NewFullStarBrush)
+{
+	if (EmptyStarBrush != NewEmptyStarBrush || FullStarBrush != NewFullStarBrush)
+	{
+		EmptyStarBrush = NewEmptyStarBrush;
+		FullStarBrush = NewFullStarBrush;
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+// Sets the size of each star and the space between them
+void SPSStarBar::SetStarLayout(const FVector2D& NewStarSize, float NewStarSpacing)
+{
+	if (StarSize != NewStarSize || StarSpacing != NewStarSpacing)
+	{
+		StarSize = NewStarSize;
+		StarSpacing = NewStarSpacing;
+		Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+// Paints all stars
+int32 SPSStarBar::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+	const FLinearColor ColorAndOpacity = InWidgetStyle.GetColorAndOpacityTint();
+
+	// Full brush is copied once to clip its UV region per star without touching the source brush
+	FSlateBrush ClippedFullStarBrush = FullStarBrush ? *FullStarBrush : FSlateBrush();
+	const FBox2f FullUVRegion = FullStarBrush && FullStarBrush->GetUVRegion().bIsValid ? FullStarBrush->GetUVRegion() : FBox2f(FVector2f::ZeroVector, FVector2f::UnitVector);
+
+	for (int32 Index = 0; Index < StarFills.Num(); ++Index)
+	{
+		const FVector2D StarOffset((StarSize.X + StarSpacing) * Index, 0.f);
+
+		if (EmptyStarBrush)
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(StarSize, FSlateLayoutTransform(StarOffset)),
+			                           EmptyStarBrush, DrawEffects, ColorAndOpacity * EmptyStarBrush->GetTint(InWidgetStyle));
+		}
+
+		const float Fill = FMath::Clamp(StarFills[Index], 0.f, 1.f);
+		if (FullStarBrush && Fill > 0.f)
+		{
+			// Draw only the filled part of the star
+			const FVector2D FilledSize(StarSize.X * Fill, StarSize.Y);
+			FBox2f FilledUVRegion = FullUVRegion;
+			FilledUVRegion.Max.X = FMath::Lerp(FullUVRegion.Min.X, FullUVRegion.Max.X, Fill);
+			ClippedFullStarBrush.SetUVRegion(FilledUVRegion);
+
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(FilledSize, FSlateLayoutTransform(StarOffset)),
+			                           &ClippedFullStarBrush, DrawEffects, ColorAndOpacity * FullStarBrush->GetTint(InWidgetStyle));
+		}
+	}
+
+	return LayerId + 1;
+}
+
+// Returns the size of all stars with spaces between them
+FVector2D SPSStarBar::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	const int32 StarsNum = StarFills.Num();
+	if (StarsNum == 0)
+	{
+		return FVector2D::ZeroVector;
+	}
+	return FVector2D(StarSize.X * StarsNum + StarSpacing * (StarsNum - 1), StarSize.Y);
+}
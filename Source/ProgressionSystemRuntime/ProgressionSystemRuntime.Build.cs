@@ -12,6 +12,7 @@ public class ProgressionSystemRuntime : ModuleRules
 		PublicDependencyModuleNames.AddRange(new[]
 			{
 				"Core", "UMG" 
+				, "ProgressionSystemCore" // Data, save and reward logic, this module implements its presentation
 				// Bomber modules
 				, "Bomber"
 				,"SettingsWidgetConstructor"
@@ -27,5 +28,11 @@ public class ProgressionSystemRuntime : ModuleRules
 				, "MetaCheatManager" // PSCheatExtension
 			}
 		);
+
+		if (Target.bBuildEditor)
+		{
+			// The menu widget test of PSWidgetInvalidationTests starts the PIE session
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 	}
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Components/ActorComponent.h"
 #include "GameFramework/MyPlayerState.h"
 #include "Structures/PlayerTag.h"
+#include "Data/PSContext.h"
 //---
 #include "PSHUDComponent.generated.h"
 
@@ -14,7 +15,7 @@
  */
 
 UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
-class PROGRESSIONSYSTEMRUNTIME_API UPSHUDComponent final : public UActorComponent
+class PROGRESSIONSYSTEMRUNTIME_API UPSHUDComponent final : public UActorComponent, public TPSContextOwner<UPSHUDComponent>
 {
 	GENERATED_BODY()
 
@@ -22,23 +23,35 @@ public:
 	/** Sets default values for this component's properties. */
 	UPSHUDComponent();
 
-	/** Save the progression depends on EEndGameState. */
+	/** Queues the end game result of the local player of this HUD, it's saved by the next progression flush. */
 	UFUNCTION(BlueprintCallable, Category="C++")
 	void SavePoints(EEndGameState EndGameState);
 	
-	/** Updates the progression menu widget when player changed */
+	/** Updates the progression menu widget and the level overlay when player changed */
 	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
 	void UpdateProgressionWidgetForPlayer();
+
+	/** Creates, shows and updates the stars of the progression menu widget, is called by the progression flush */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void UpdateProgressionMenuWidget();
+
+	/** Shows or hides the level overlay by the lock state of the current level, is called by the progression flush */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void UpdateLevelUIOverlay();
+
+	/** Updates only the stars of the menu widget by the displayed level progression, is called by the stars count-up every frame */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void UpdateProgressionStars();
 	
 	/*********************************************************************************************
 	* Protected properties
 	********************************************************************************************* */
 protected:
-	/** Created Main Menu widget. */
+	/** Created Main Menu widget, is created on its first display. */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression Menu Widget"))
 	TObjectPtr<class UPSMenuWidget> ProgressionMenuWidgetInternal = nullptr;
 
-	/** Created Main Menu overlay widget. */
+	/** Created Main Menu overlay widget, is created on its first display. */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression Menu Overaly Widget"))
 	TObjectPtr<class UPSOverlayWidget> ProgressionMenuOverlayWidgetInternal = nullptr;
 	
@@ -81,6 +94,12 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
 	void OnLocalCharacterReady(class APlayerCharacter* Character, int32 CharacterID);
 
+	/** Returns the menu widget, creates it on the first call */
+	class UPSMenuWidget& GetOrCreateMenuWidget();
+
+	/** Returns the overlay widget, creates it on the first call */
+	class UPSOverlayWidget& GetOrCreateOverlayWidget();
+
 	/** Show locked level ui overlay */
 	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
 	void DisplayLevelUIOverlay(bool IsLevelLocked);
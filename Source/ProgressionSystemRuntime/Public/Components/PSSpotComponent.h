@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Data/PSTypes.h"
+#include "Data/PSContext.h"
 #include "Components/ActorComponent.h"
 #include "PSSpotComponent.generated.h"
 
@@ -11,7 +12,7 @@
  * Is added dynamically to the My Skeletal Mesh actors on the level.
  */
 UCLASS(Blueprintable, BlueprintType, ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
-class PROGRESSIONSYSTEMRUNTIME_API UPSSpotComponent : public UActorComponent
+class PROGRESSIONSYSTEMRUNTIME_API UPSSpotComponent : public UActorComponent, public TPSContextOwner<UPSSpotComponent>
 {
 	GENERATED_BODY()
 
@@ -30,7 +31,7 @@ public:
 	UFUNCTION(BlueprintPure, Category = "C++")
 	FORCEINLINE class UMySkeletalMeshComponent* GetPlayerSpotOnLevel() const { return PlayerSpotOnLevelInternal; }
 
-	/* Delegate for informing about loading spot component */
+	/* Delegate for informing about loading spot component, C++ listeners should use FPSEventBus::SpotReady */
 	UPROPERTY(BlueprintAssignable, Transient, Category = "C++")
 	FPSSpotComponent OnSpotComponentReady;
 
@@ -0,0 +1,86 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UPSWorldSubsystem;
+class UPSDataAsset;
+struct FPSRowData;
+struct FPSSaveToDiskData;
+struct FPSPresentationData;
+
+/**
+ * Lightweight handle to the progression of one world: its subsystem, data asset and current row of the owning local player.
+ * Is resolved once by its owner (component, actor or widget) and then used on hot paths without global lookups.
+ */
+struct PROGRESSIONSYSTEMRUNTIME_API FPSContext
+{
+	/** Resolves the context from the world of given object, does nothing if it's already resolved. */
+	void ResolveIfNeeded(const UObject& WorldContextObject);
+
+	/** Returns true if both the subsystem and the data asset are resolved and still alive. */
+	bool IsValid() const;
+
+	/** Clears resolved references, e.g. when the owner is unregistered. */
+	void Reset();
+
+	/** Returns the progression subsystem of the resolved world, is null if it's not resolved or already deinitialized. */
+	FORCEINLINE UPSWorldSubsystem* GetSubsystem() const { return SubsystemInternal.Get(); }
+
+	/** Returns the progression subsystem of the resolved world, is checked. */
+	UPSWorldSubsystem& GetSubsystemChecked() const;
+
+	/** Returns the progression data asset, is checked. */
+	const UPSDataAsset& GetDataAssetChecked() const;
+
+	/** Returns the local player who owns the resolved object, 0 if it's not owned by any local player. */
+	FORCEINLINE int32 GetLocalPlayerIndex() const { return LocalPlayerIndexInternal; }
+
+	/** Returns the current progression row name. */
+	FName GetCurrentRowName() const;
+
+	/** Returns the settings of the current progression row. */
+	const FPSRowData& GetCurrentSettingsRow() const;
+
+	/** Returns the saved data of the current progression row. */
+	const FPSSaveToDiskData& GetCurrentSaveRow() const;
+
+	/** Returns the cached presentation of the current progression row. */
+	const FPSPresentationData& GetCurrentPresentation() const;
+
+protected:
+	/** The progression subsystem of the owner's world */
+	TWeakObjectPtr<UPSWorldSubsystem> SubsystemInternal = nullptr;
+
+	/** The progression data asset loaded by the subsystem */
+	TWeakObjectPtr<const UPSDataAsset> DataAssetInternal = nullptr;
+
+	/** The local player who owns the resolved object */
+	int32 LocalPlayerIndexInternal = 0;
+};
+
+/**
+ * Gives the progression context to its owner, is inherited by components, actors and widgets that use the progression on hot paths.
+ * The context is resolved from the owner's world on the first use.
+ * @tparam TOwner The object class that inherits it, e.g. class UPSHUDComponent : public UActorComponent, public TPSContextOwner<UPSHUDComponent>
+ */
+template <typename TOwner>
+class TPSContextOwner
+{
+protected:
+	/** Returns the progression context of the owner's world, is resolved on the first call. */
+	const FPSContext& GetPSContext() const
+	{
+		PSContextInternal.ResolveIfNeeded(*static_cast<const TOwner*>(this));
+		return PSContextInternal;
+	}
+
+	/** Clears the resolved context, e.g. when the owner is unregistered, so it's resolved again by the next world. */
+	void ResetPSContext() { PSContextInternal.Reset(); }
+
+private:
+	/** The progression of the owner's world, is resolved on the first use to avoid global lookups on hot paths */
+	mutable FPSContext PSContextInternal;
+};
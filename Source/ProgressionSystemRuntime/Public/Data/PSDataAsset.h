@@ -3,8 +3,10 @@
 #pragma once
 
 #include "Data/MyPrimaryDataAsset.h"
+#include "Data/PSTypes.h"
 #include "Data/SettingTag.h"
 #include "Structures/ManageableWidgetData.h"
+#include "Styling/SlateBrush.h"
 #include "PSDataAsset.generated.h"
 
 enum class EGameDifficulty : uint8;
@@ -20,6 +22,7 @@ class PROGRESSIONSYSTEMRUNTIME_API UPSDataAsset : public UMyPrimaryDataAsset
 public:
 	/** Returns the progression data asset or crash if can not be obtained. */
 	static const UPSDataAsset& Get();
+	static const UPSDataAsset& Get(const UObject& WorldContextObject);
 
 	/** Returns the Progression Data Table
 	 * @see UProgressionSystemDataAsset::ProgressionDataTableInternal */
@@ -42,6 +45,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "C++")
 	FORCEINLINE class UTexture2D* GetUnlockedProgressionIcon() const { return UnlockedProgressionIconInternal; }
 
+	/** Returns the brush of the locked star, it points to the star icons atlas if it was built */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	const FORCEINLINE FSlateBrush& GetLockedStarBrush() const { return LockedStarBrushInternal; }
+
+	/** Returns the brush of the unlocked star, it points to the star icons atlas if it was built */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	const FORCEINLINE FSlateBrush& GetUnlockedStarBrush() const { return UnlockedStarBrushInternal; }
+
 	/** Returns a star widget  */
 	UFUNCTION(BlueprintPure, Category = "C++")
 	FORCEINLINE TSubclassOf<class UPSStarWidget> GetStarWidgetClass() const { return StarWidgetInternal; }
@@ -50,17 +61,21 @@ public:
 	UFUNCTION(BlueprintPure, Category = "C++")
 	FORCEINLINE TSubclassOf<class AActor> GetStarActorClass() const { return StarActorClassInternal; }
 
-	/** Returns Material applied for locked progression material (star is empty) */
+	/** Returns the single material of star actors, fill and lock values are passed per star through custom primitive data */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FORCEINLINE class UMaterialInterface* GetLockedProgressionMaterial() const { return LockedProgressionMaterialInternal; }
+	FORCEINLINE class UMaterialInterface* GetStarProgressionMaterial() const { return StarProgressionMaterialInternal; }
 
-	/** Returns Material applied for unlocked progression material (star is fully filled) */
+	/** Returns the custom primitive data index of the star fill value, 0 is empty star and 1 is fully filled */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FORCEINLINE class UMaterialInterface* GetUnlockedProgressionMaterial() const { return UnlockedProgressionMaterialInternal; }
+	FORCEINLINE int32 GetStarFillPrimitiveDataIndex() const { return StarFillPrimitiveDataIndexInternal; }
 
-	/** Returns Material applied for dynamic progression material (star is filled partially depends on progression) */
+	/** Returns the custom primitive data index of the star lock value, 1 is locked star and 0 is unlocked */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FORCEINLINE class UMaterialInterface* GetDynamicProgressionMaterial() const { return DynamicProgressionMaterialInternal; }
+	FORCEINLINE int32 GetStarLockPrimitiveDataIndex() const { return StarLockPrimitiveDataIndexInternal; }
+
+	/** Returns the formation of stars above the character on the level, is the Line formation if the row has no formation set */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	const FPSStarsFormationData& GetStarsFormation(FName RowName) const;
 
 	/** Returns progression difficulty multiplier */
 	UFUNCTION(BlueprintPure, Category = "C++")
@@ -70,11 +85,11 @@ public:
 	UFUNCTION(BlueprintPure, Category = "C++")
 	FORCEINLINE float GetOverlayFadeDuration() const { return FadeDurationInternal; }
 
-	/** Star Material Slot name to change the dynamic fill-in based on the progression */
+	/** Returns the duration of filling one earned star by the count-up animation at the end of the match */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FORCEINLINE FName GetStarMaterialSlotName() const { return StarMaterialSlotNameInternal; }
+	FORCEINLINE float GetStarCountUpDuration() const { return StarCountUpDurationInternal; }
 
-	/** Returns temp value to tweak the stars with bad UV  to look as expected. Could not be 0 */
+	/** Returns temp value to tweak the stars with bad UV  to look as expected, divides any star fill. Could not be 0 */
 	UFUNCTION(BlueprintPure, Category = "C++")
 	FORCEINLINE float GetStarMaterialFractionalDivisor() const { return StarMaterialFractionalDivisorInternal; }
 
@@ -82,6 +97,33 @@ public:
 	UFUNCTION(BlueprintPure, Category = "C++")
 	FORCEINLINE FSettingTag GetInstantCharacterSwitchTag() const { return InstantCharacterSwitchTagInternal; }
 
+	/** Returns the maximum amount of stars displayed for a level, above it stars are shown in a compact way. 0 means no limit */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE int32 GetMaxStarsToDisplay() const { return MaxStarsToDisplayInternal; }
+
+	/** Returns the amount of stars to display for given points to unlock, is capped by the maximum amount of stars to display */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	int32 GetStarsToDisplayNum(float PointsToUnlock) const;
+
+	/** Returns the maximum amount of star actors kept in the pool between menu and game transitions */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE int32 GetMaxPooledStarActors() const { return MaxPooledStarActorsInternal; }
+
+	/** Returns the maximum amount of star widgets kept in the pool between menu and game transitions */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE int32 GetMaxPooledStarWidgets() const { return MaxPooledStarWidgetsInternal; }
+
+	/** Returns the scale to convert progression points into displayed stars, is 1 when the level is not compacted */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	float GetStarsDisplayScale(float PointsToUnlock) const;
+
+#if WITH_EDITOR
+	/** Packs the locked and unlocked icons into the single star icons atlas and updates star brushes to its UV regions.
+	 * Is called automatically when any icon is changed. */
+	UFUNCTION(CallInEditor, Category = "UI")
+	void RebuildStarIconsAtlas();
+#endif
+
 protected:
 	/** The Progression Data Table that is responsible for progression configuration. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (BlueprintProtected, DisplayName = "Progression Data Table", ShowOnlyInnerProperties))
@@ -111,17 +153,47 @@ protected:
 	UPROPERTY(EditAnywhere)
 	TObjectPtr<class UTexture2D> UnlockedProgressionIconInternal = nullptr;
 
-	/** Material applied for locked progression material (star is empty) */
-	UPROPERTY(EditAnywhere)
-	TObjectPtr<class UMaterialInterface> LockedProgressionMaterialInternal = nullptr;
+	/** Single texture that contains both locked and unlocked icons, so all stars are drawn with the same resource and batched by Slate.
+	 * Is generated from the icons, icons source has to be in BGRA8 format.
+	 * @see UPSDataAsset::RebuildStarIconsAtlas */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (BlueprintProtected, DisplayName = "Star Icons Atlas"))
+	TObjectPtr<class UTexture2D> StarIconsAtlasInternal = nullptr;
 
-	/** Material applied for unlocked progression material (star is fully filled) */
-	UPROPERTY(EditAnywhere)
-	TObjectPtr<class UMaterialInterface> UnlockedProgressionMaterialInternal = nullptr;
+	/** Brush of the locked star, points to the locked icon region of the star icons atlas, or to the locked icon if the atlas is not built. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (BlueprintProtected, DisplayName = "Locked Star Brush"))
+	FSlateBrush LockedStarBrushInternal;
 
-	/** Material applied for dynamic progression material (star is filled partially depends on progression) */
+	/** Brush of the unlocked star, points to the unlocked icon region of the star icons atlas, or to the unlocked icon if the atlas is not built.
+	 * The partially unlocked star is the same brush clipped by the star fill. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (BlueprintProtected, DisplayName = "Unlocked Star Brush"))
+	FSlateBrush UnlockedStarBrushInternal;
+
+	/** The single material of star actors, it has to read fill and lock values from custom primitive data
+	 * @see UPSDataAsset::StarFillPrimitiveDataIndexInternal
+	 * @see UPSDataAsset::StarLockPrimitiveDataIndexInternal */
 	UPROPERTY(EditAnywhere)
-	TObjectPtr<class UMaterialInterface> DynamicProgressionMaterialInternal = nullptr;
+	TObjectPtr<class UMaterialInterface> StarProgressionMaterialInternal = nullptr;
+
+	/** Is loaded from assets saved before the single star material, is moved to the Star Progression Material on load */
+	UPROPERTY()
+	TObjectPtr<class UMaterialInterface> DynamicProgressionMaterialInternal_DEPRECATED = nullptr;
+
+	/** Is loaded from assets saved before the single star material, is moved to the Star Progression Material on load if there is no dynamic one */
+	UPROPERTY()
+	TObjectPtr<class UMaterialInterface> UnlockedProgressionMaterialInternal_DEPRECATED = nullptr;
+
+	/** Custom primitive data index of the star fill value, has to match the index set in the star material */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Fill Primitive Data Index", ClampMin = "0"))
+	int32 StarFillPrimitiveDataIndexInternal = 0;
+
+	/** Custom primitive data index of the star lock value, has to match the index set in the star material */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Lock Primitive Data Index", ClampMin = "0"))
+	int32 StarLockPrimitiveDataIndexInternal = 1;
+
+	/** Formation of stars above the character by the row name of the progression data table.
+	 * Is kept here since it's only needed to present the progression, rows that are not listed use the Line formation. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI", meta = (BlueprintProtected, DisplayName = "Stars Formations"))
+	TMap<FName, FPSStarsFormationData> StarsFormationsInternal;
 
 	/** The Progression difficulty multiplier. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (BlueprintProtected, DisplayName = "Progression Multiplier", ShowOnlyInnerProperties))
@@ -131,16 +203,52 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Fade duration"))
 	float FadeDurationInternal = 1.0;
 
-	/** Star Material Slot name to change the dynamic fill-in based on the progression */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Material Slot Name"))
-	FName StarMaterialSlotNameInternal = NAME_None;
+	/** Duration of filling one earned star by the count-up animation at the end of the match, stars are filled in sequence.
+	 * 0 disables the animation, it's also not played when Instant Character Switch setting is enabled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Count-Up Duration", ClampMin = "0", Units = "Seconds"))
+	float StarCountUpDurationInternal = 0.3f;
 
 	/** Temporary used to tweak the stars with bad UV  to look as expected
+	 * Divides the fill of any unlocked star, so the fill stays monotonic: the material has to display 1/Divisor as the full star.
 	 * Since it's a divisor couldn't be 0 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Material Fractional Divisor Temporary"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Material Fractional Divisor Temporary", ClampMin = "0.01"))
 	float StarMaterialFractionalDivisorInternal = 1.f;
 
 	/** When Instant character switch setting enabled fade animation will not be played */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "C++", AdvancedDisplay, meta = (BlueprintProtected, DisplayName = "Instant Character Switch Tag"))
 	FSettingTag InstantCharacterSwitchTagInternal = FSettingTag::EmptySettingTag;
+
+	/** Maximum amount of stars displayed for a level both in the main menu widget and above the character.
+	 * If level requires more points, each star represents a segment of points and a counter is shown instead.
+	 * Bounds the amount of spawned star actors and widgets regardless of the level design values. 0 means no limit */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI", meta = (BlueprintProtected, DisplayName = "Max Stars To Display", ClampMin = "0"))
+	int32 MaxStarsToDisplayInternal = 0;
+
+	/** Maximum amount of star actors kept in the pool when progression is cleaned up, so they are not re-spawned on the next return to the main menu.
+	 * If more stars were spawned, only the surplus is destroyed. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pool", meta = (BlueprintProtected, DisplayName = "Max Pooled Star Actors", ClampMin = "0"))
+	int32 MaxPooledStarActorsInternal = 20;
+
+	/** Maximum amount of star widgets kept in the pool when the menu widget is destroyed, so they are not re-created on the next return to the main menu.
+	 * If more widgets were created, only the surplus is destroyed. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pool", meta = (BlueprintProtected, DisplayName = "Max Pooled Star Widgets", ClampMin = "0"))
+	int32 MaxPooledStarWidgetsInternal = 20;
+
+	/** Points star brushes to the standalone icons if the atlas was never built, e.g. the asset was saved before the atlas existed.
+	 * Moves the star material of assets saved before the single star material. */
+	virtual void PostLoad() override;
+
+	/** Points star brushes to the standalone icons, stars still work but are not batched. */
+	void ApplyStandaloneStarBrushes();
+
+#if WITH_EDITOR
+	/** Rebuilds the star icons atlas when any icon is changed. */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	/** Fails if the star material doesn't read fill and lock values from custom primitive data, e.g. it still reads the scalar parameter of old materials. */
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+
+	/** Returns true if the star material has scalar parameters that read both fill and lock custom primitive data indices. */
+	bool DoesStarMaterialReadPrimitiveData() const;
+#endif
 };
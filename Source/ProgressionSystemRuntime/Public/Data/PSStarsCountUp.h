@@ -0,0 +1,65 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Plays the count-up animation that fills earned stars in sequence for each local player, is owned by the world subsystem.
+ * All local players are counted up on the same clock, it's registered only while any animation is playing.
+ */
+class PROGRESSIONSYSTEMRUNTIME_API FPSStarsCountUp
+{
+public:
+	/** Is called on each tick of the local player whose displayed progression is changed, the last call is made once the animation is complete. */
+	DECLARE_DELEGATE_OneParam(FPSOnCountUpUpdated, int32 /*LocalPlayerIndex*/);
+	FPSOnCountUpUpdated OnUpdated;
+
+	/** Unregisters the clock, so it's never called after the owner is destroyed. */
+	~FPSStarsCountUp() { StopAll(); }
+
+	/** Starts the animation of the local player from given progression, the previous animation of this player is replaced.
+	 * @param LocalPlayerIndex The local player whose stars are counted up.
+	 * @param FromPoints The level progression displayed before points were earned.
+	 * @param Duration Time to count up to the saved progression, in seconds. */
+	void Play(int32 LocalPlayerIndex, float FromPoints, float Duration);
+
+	/** Stops the animation of the local player, its stars display the saved progression. */
+	void Stop(int32 LocalPlayerIndex);
+
+	/** Stops animations of all local players and unregisters the clock. */
+	void StopAll();
+
+	/** Returns true if the animation of the local player is playing. */
+	bool IsPlaying(int32 LocalPlayerIndex) const;
+
+	/** Returns the level progression displayed by stars of the local player, is behind the saved one while the animation is playing. */
+	float GetDisplayedProgression(int32 LocalPlayerIndex, float SavedProgression) const;
+
+protected:
+	/** The animation state of one local player */
+	struct FPSCountUpAnimation
+	{
+		/** True while the animation is playing */
+		bool bIsPlaying = false;
+
+		/** The level progression from which the animation is playing */
+		float FromPoints = 0.f;
+
+		/** Time passed since the animation started, in seconds */
+		float ElapsedTime = 0.f;
+
+		/** Total duration of the animation, in seconds */
+		float Duration = 0.f;
+	};
+
+	/** Animations by the local player index */
+	TArray<FPSCountUpAnimation, TInlineAllocator<4>> AnimationsInternal;
+
+	/** The single clock of all animations, is registered only while any animation is playing */
+	FTSTicker::FDelegateHandle TickerHandleInternal;
+
+	/** Advances animations of all local players, returns false once all of them are complete to unregister the clock. */
+	bool Tick(float DeltaTime);
+};
@@ -0,0 +1,30 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPSRowData;
+struct FPSStarsFormationData;
+struct FPSStarsLayoutData;
+
+/**
+ * Computes the transforms of all star actors of a progression row in a single pass.
+ * Star actors only receive the finished transforms, so they don't depend on each other.
+ */
+struct PROGRESSIONSYSTEMRUNTIME_API FPSStarsLayout
+{
+	/** Returns the hash of the row settings which affect the layout, is used to invalidate the cached layout. */
+	static uint32 GetLayoutHash(const FPSRowData& RowData, const FPSStarsFormationData& FormationData, int32 StarsNum);
+
+	/** Computes world transforms of all stars in the row according to its formation.
+	 * @param RowData The progression row settings with the base transform of the stars.
+	 * @param FormationData The formation of the stars of the row.
+	 * @param StarsNum The amount of stars to place.
+	 * @param OutLayoutData Is filled with the transforms and the hash of settings they were computed with. */
+	static void ComputeLayout(const FPSRowData& RowData, const FPSStarsFormationData& FormationData, int32 StarsNum, FPSStarsLayoutData& OutLayoutData);
+
+protected:
+	/** Returns the offset of the star from the base transform location by its index. */
+	static FVector GetStarOffset(const FPSRowData& RowData, const FPSStarsFormationData& FormationData, int32 StarIndex, int32 StarsNum);
+};
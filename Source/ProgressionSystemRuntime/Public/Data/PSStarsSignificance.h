@@ -0,0 +1,57 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class APSStarActor;
+
+/**
+ * Settings of the star actors significance, are configured in the world subsystem.
+ */
+struct FPSStarsSignificanceSettings
+{
+	/** Maximum amount of visible star actors animated at full frame rate */
+	int32 MaxSignificantStars = 10;
+
+	/** Distance from the camera after which star actors are considered as low significant */
+	float SignificanceDistance = 3000.f;
+
+	/** Tick interval of low significant star actors, in seconds */
+	float ReducedTickInterval = 0.1f;
+
+	/** If true, star actors which are not rendered freeze on their current pose */
+	bool bFreezeNotRendered = true;
+};
+
+/**
+ * Throttles animations of star actors by their significance, is owned by the world subsystem.
+ * Each star is scored by the closest camera of all local players, so stars seen by any split-screen player are animated at full rate.
+ */
+class PROGRESSIONSYSTEMRUNTIME_API FPSStarsSignificance
+{
+public:
+	/** Returns the significance of the star: 1 at the closest camera, 0 if it's too far from all cameras, -1 if it's not rendered. */
+	static float GetStarSignificance(const FVector& StarLocation, bool bIsRendered, TConstArrayView<FVector> CameraLocations, float SignificanceDistance);
+
+	/** Starts evaluating the significance periodically, does nothing if it's already started or the interval is 0. */
+	void Start(UWorld& World, float UpdateInterval, const FTimerDelegate& UpdateDelegate);
+
+	/** Stops evaluating the significance, star actors keep their last throttling. */
+	void Stop(const UWorld* World);
+
+	/** Scores each star by cameras of all local players and throttles animations of low significant stars.
+	 * @return false if there are no stars or cameras to evaluate, so the evaluation can be stopped. */
+	bool Update(const UWorld& World, TConstArrayView<TObjectPtr<APSStarActor>> StarActors, const FPSStarsSignificanceSettings& Settings);
+
+protected:
+	/** Handle of the looping timer that evaluates the significance */
+	FTimerHandle TimerHandleInternal;
+
+	/** Camera locations of all local players, is kept to reuse its allocation */
+	TArray<FVector, TInlineAllocator<4>> CameraLocationsInternal;
+
+	/** Stars sorted by their significance, is kept to reuse its allocation */
+	TArray<TPair<float, APSStarActor*>> ScoredStarsInternal;
+};
@@ -2,81 +2,255 @@
 
 #pragma once
 
-#include "Bomber.h"
-#include "Structures/PlayerTag.h"
-#include "Engine/DataTable.h"
+#include "Data/PSCoreTypes.h"
+#include "UObject/ObjectKey.h"
 #include "PSTypes.generated.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Star Actors Spawned"), STAT_PSStarActorsSpawned, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Star Actors Reused"), STAT_PSStarActorsReused, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Star Widgets Spawned"), STAT_PSStarWidgetsSpawned, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Star Widgets Reused"), STAT_PSStarWidgetsReused, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Progression Updates Requested"), STAT_PSUpdatesRequested, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Progression Updates Coalesced"), STAT_PSUpdatesCoalesced, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Progression Updates Flushed"), STAT_PSUpdatesFlushed, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Global Subsystem Lookups"), STAT_PSGlobalLookups, STATGROUP_ProgressionSystem, PROGRESSIONSYSTEMRUNTIME_API);
+
+/**
+ * Progression consumers that have to be refreshed, are flushed once per frame.
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EPSDirtyFlags : uint8
+{
+	None = 0 UMETA(Hidden),
+	///< Star actors above the character
+	Stars = 1 << 0,
+	///< Stars of the main menu and end-game widget
+	MenuWidget = 1 << 1,
+	///< Overlay of the locked level
+	Overlay = 1 << 2,
+	///< Lock state of the player spot
+	Spot = 1 << 3,
+	///< End-game results of local players that have to be saved, is applied before consumers are refreshed
+	EndGameResults = 1 << 4,
+	///< All consumers
+	All = Stars | MenuWidget | Overlay | Spot UMETA(Hidden),
+};
+
+ENUM_CLASS_FLAGS(EPSDirtyFlags);
+
+/**
+ * Independent stages of the progression initialization, they run concurrently and are joined into the single ready event.
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EPSInitStage : uint8
+{
+	None = 0 UMETA(Hidden),
+	///< Async loading of the data asset with all its hard references
+	DataAsset = 1 << 0,
+	///< Copying rows of the progression data table, is started once the data asset is loaded
+	DataTable = 1 << 1,
+	///< Async loading and decoding of the save profile of the primary player
+	SaveGame = 1 << 2,
+	///< Spawning star actors to the pool, is started once the data asset is loaded
+	StarsPool = 1 << 3,
+	///< All stages
+	All = DataAsset | DataTable | SaveGame | StarsPool UMETA(Hidden),
+};
+
+ENUM_CLASS_FLAGS(EPSInitStage);
+
+/**
+ * Defines the shape in which the stars above the character are placed.
+ */
+UENUM(BlueprintType, DisplayName = "Star Actors Formation")
+enum class EPSStarsFormation : uint8
+{
+	///< Stars are placed one by one with the offset between them
+	Line,
+	///< Stars are placed on the vertical arc, the middle star is the highest one
+	Arc,
+	///< Stars are placed around the character on the horizontal circle
+	Ring,
+	///< Stars are placed in rows with the given amount of columns
+	Grid,
+};
+
 /**
- * Basic structure for all progression settings data
- * Initial load performed once based on the data in the DT Table and never changed later
+ * Describes the formation settings of the stars above the character.
  */
 USTRUCT(BlueprintType)
-struct FPSRowData : public FTableRowBase
+struct PROGRESSIONSYSTEMRUNTIME_API FPSStarsFormationData
 {
 	GENERATED_BODY()
 
-	static const FPSRowData EmptyData;
+	static const FPSStarsFormationData EmptyData;
 
-	/** Default constructor. */
-	FPSRowData() = default;
-
-	/** Stores the value of the map for progression system component */
+	/** The shape in which stars are placed */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	ELevelType Map = ELevelType::None;
+	EPSStarsFormation Formation = EPSStarsFormation::Line;
 
-	/** Contains the character player tag used in the save/load progression system */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	FPlayerTag Character = FPlayerTag::None;
+	/** Radius of the Arc and Ring formations */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++", meta = (EditCondition = "Formation == EPSStarsFormation::Arc || Formation == EPSStarsFormation::Ring", ClampMin = "0"))
+	float Radius = 100.f;
 
-	/** Transform of Stars above the character on a level */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	FTransform StarActorTransform = FTransform::Identity;
+	/** Angle in degrees covered by the Arc formation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++", meta = (EditCondition = "Formation == EPSStarsFormation::Arc", ClampMin = "0", ClampMax = "360"))
+	float ArcAngle = 90.f;
 
-	/** Offset between stars for stars above the character on a level */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	FVector OffsetBetweenStarActors = FVector::ZeroVector;
+	/** Amount of stars in one row of the Grid formation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++", meta = (EditCondition = "Formation == EPSStarsFormation::Grid", ClampMin = "1"))
+	int32 GridColumns = 5;
 
-	/** Required about of points to unlock level  */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	float PointsToUnlock = 0.f;
+	/** Offset between rows of the Grid formation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++", meta = (EditCondition = "Formation == EPSStarsFormation::Grid"))
+	FVector GridRowOffset = FVector(0.f, 0.f, -50.f);
 
-	/** Base scores per end-game result before applying difficulty multiplier. E.g. the number of stars a player receives upon winning the game. 
-	* If End-Game state is not matching with game result, 0 score will be granted by default. */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="C++", meta = (DisplayName = "Progression End Game States"))
-	TMap<EEndGameState, float> ProgressionEndGameValues;
+	/** Creates a hash value from the formation settings. */
+	friend PROGRESSIONSYSTEMRUNTIME_API uint32 GetTypeHash(const FPSStarsFormationData& FormationData);
+};
 
-	/** Defines the star animations for each character called when in-game cinematic played */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	TObjectPtr<class UCurveTable> HideStarsAnimation = nullptr;
+/**
+ * Contains the precomputed transforms of all star actors for a progression row.
+ * Is cached once per row and invalidated only when the row settings are changed.
+ */
+USTRUCT(BlueprintType)
+struct FPSStarsLayoutData
+{
+	GENERATED_BODY()
 
-	/** Defines the star animations for each character called when in-game cinematic played */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	TObjectPtr<class UCurveTable> MenuStarsAnimation = nullptr;
+	/** Hash of the row settings the layout was computed with, is not exposed to Blueprints since they don't support uint32 */
+	UPROPERTY(VisibleInstanceOnly, Category="C++")
+	uint32 SettingsHash = 0;
+
+	/** World transforms of each star in the row */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TArray<FTransform> StarTransforms;
 };
 
 /**
- *  Basic structure for all save data information regarding the progression
- *  The data can be modified in run-time and saved to the disk
- *  Same structure will be reflected in the save file. 
+ * Tracks the usage of pooled progression objects (star actors, star widgets).
+ * Counts objects actually received from the pool: an object received for the first time was spawned, received again was reused.
  */
 USTRUCT(BlueprintType)
-struct FPSSaveToDiskData
+struct FPSPoolUsageData
 {
 	GENERATED_BODY()
 
-	static const FPSSaveToDiskData EmptyData;
+	/** Amount of objects the pool had to spawn */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	int32 SpawnedNum = 0;
 
-	/** Default constructor. */
-	FPSSaveToDiskData() = default;
+	/** Amount of objects the pool returned again instead of spawning new ones */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	int32 ReusedNum = 0;
 
-	/** Current progression for each level  */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	float CurrentLevelProgression = 0.f;
+	/** Objects received from the pool at least once, keys don't keep them alive, so the pool still owns them */
+	TSet<FObjectKey> KnownObjects;
 
-	/** Defines if level is locked or not */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="C++")
-	bool IsLevelLocked = true;
+	/** Registers the object received from the pool.
+	 * @return true if the object was received before, so it's reused instead of spawned. */
+	bool AddTakenObject(const UObject* Object)
+	{
+		bool bIsReused = false;
+		KnownObjects.Add(FObjectKey(Object), &bIsReused);
+		++(bIsReused ? ReusedNum : SpawnedNum);
+		return bIsReused;
+	}
+
+	/** Forgets the object destroyed by the pool trim. */
+	void RemoveObject(const UObject* Object) { KnownObjects.Remove(FObjectKey(Object)); }
+};
+
+/**
+ * Contains everything needed to present the progression of a row: stars of the menu widget and above the character, overlay and spot lock.
+ * Is precomputed per row after load and after each save, so switching the character only applies the cached state.
+ */
+USTRUCT(BlueprintType)
+struct FPSPresentationData
+{
+	GENERATED_BODY()
+
+	static const FPSPresentationData EmptyData;
+
+	/** Fill of each displayed star, 0 is the locked star and 1 is the fully unlocked star */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TArray<float> StarFills;
+
+	/** Achieved points of the level, is capped by the points to unlock */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	float LevelProgression = 0.f;
+
+	/** Required amount of points to unlock the level */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	float PointsToUnlock = 0.f;
+
+	/** True if each star represents more than one point, so the counter has to be displayed */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	bool bIsCompacted = false;
+
+	/** True if the level is locked, so the overlay is shown and the spot is deactivated */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	bool bIsLevelLocked = true;
+};
+
+/**
+ * The progression of one local player, there are few of them in split-screen.
+ * Is held by the world subsystem in the array by the local player index, 0 is the primary player.
+ */
+USTRUCT(BlueprintType)
+struct FPSLocalPlayerData
+{
+	GENERATED_BODY()
+
+	static const FPSLocalPlayerData EmptyData;
+
+	/** The current progression row of this player, is changed when the character is switched */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	FName CurrentRowName = NAME_None;
+
+	/** The component that displays the progression widgets of this player */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TObjectPtr<class UPSHUDComponent> HUDComponent = nullptr;
+
+	/** The spot of the character chosen by this player */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TObjectPtr<class UPSSpotComponent> SpotComponent = nullptr;
+
+	/** The save profile of this player */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TObjectPtr<class UPSSaveGameData> SaveGameData = nullptr;
+
+	/** Is set in network games, the server owns the progression of this player and replicates it by this component */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TObjectPtr<class UPSReplicationComponent> ReplicationComponent = nullptr;
+
+	/** True if the save profile was changed by the server and has to be saved on the next flush */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	bool bHasUnsavedChanges = false;
+
+	/** Precomputed presentation of each progression row by the save profile of this player */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TMap<FName, FPSPresentationData> PresentationCache;
+
+	/** Rows which progression or lock state is changed since the presentation was computed, only they are recomputed on the next save */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	TSet<FName> DirtyPresentationRows;
+
+	/** The end-game result that is not saved yet, all local players are saved at once */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	EEndGameState PendingEndGameState = EEndGameState::None;
+
+	/** Points earned by in-match events since the match started, are reduced once per frame and committed to the save at match end */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	float MatchProgress = 0.f;
+
+	/** True while the save profile is being loaded */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	bool bIsSaveLoading = false;
+
+	/** Presentation of the current row that is being updated while count-up is playing, is kept to reuse its allocation */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category="C++")
+	FPSPresentationData CountUpPresentation;
 };
 
 
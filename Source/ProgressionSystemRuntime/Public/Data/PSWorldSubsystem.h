@@ -3,8 +3,15 @@
 #pragma once
 
 #include "PSTypes.h"
+#include "Data/PSEventBus.h"
+#include "Data/PSProgressAccumulator.h"
+#include "Data/PSProgressionOwner.h"
+#include "Data/PSSnapshot.h"
+#include "Data/PSStarsCountUp.h"
+#include "Data/PSStarsSignificance.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "PoolManagerTypes.h"
+#include "Engine/EngineBaseTypes.h"
 #include "PSWorldSubsystem.generated.h"
 
 enum class ECurrentGameState : uint8;
@@ -14,88 +21,215 @@ enum class EPSStarActorState : uint8;
  * Implements the world subsystem to access different components in the module 
  */
 UCLASS(BlueprintType, Blueprintable, Config = "ProgressionSystem", DefaultConfig)
-class PROGRESSIONSYSTEMRUNTIME_API UPSWorldSubsystem : public UWorldSubsystem
+class PROGRESSIONSYSTEMRUNTIME_API UPSWorldSubsystem : public UWorldSubsystem, public IPSProgressionOwner
 {
 	GENERATED_BODY()
 
 public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCurrentRowDataChanged, const FPlayerTag, SavedProgressionRowData);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPSOnInitialize);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FPSOnProgressChanged, FName, RowName, float, PreviousProgression, float, NewProgression);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPSOnLevelUnlocked, FName, RowName);
 
-	/** Returns this Subsystem, is checked and will crash if it can't be obtained.*/
+	/** Returns this Subsystem, is checked and will crash if it can't be obtained.
+	 * The overload without context returns the subsystem of the play world, so it's ambiguous when several worlds are running (e.g. multiple PIE instances),
+	 * prefer the world context overload or FPSContext. */
 	static UPSWorldSubsystem& Get();
 	static UPSWorldSubsystem& Get(const UObject& WorldContextObject);
 
-	/** Is called to initialize the world subsystem. It's a BeginPlay logic for the PS module */
+	/** Is called to initialize the world subsystem. It's a BeginPlay logic for the PS module, loads the save profile of the primary player */
 	UFUNCTION(BlueprintNativeEvent, Category= "C++", meta = (BlueprintProtected))
 	void OnWorldSubSystemInitialize();
 
-	/** Cleanup used on unloading module to remove properties that should not be available by other objects. */
+	/** Returns true once all initialization stages are finished and FPSEventBus::Initialized is broadcast. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE bool IsProgressionReady() const { return bIsProgressionReadyInternal; }
+
+	/** Returns true if any initialization stage failed, so the progression is not available until the next world. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE bool IsProgressionFailed() const { return bIsProgressionFailedInternal; }
+
+	/** Returns how long the initialization stage took in seconds, 0 if it's not finished yet.
+	 * None returns the time from the start of initialization to the ready event. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	float GetInitStageDuration(EPSInitStage Stage) const;
+
+	/** Cleanup used on unloading module to remove properties that should not be available by other objects.
+	 * Settings and save profiles are kept by the game instance subsystem, so they are not loaded again in the next world. */
 	UFUNCTION(BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
 	void PerformCleanUp();
 	
-	/** Set current row of progression system by tag*/
+	/** Set current row of progression system by tag
+	 * @param NewRowPlayerTag The character which row becomes current
+	 * @param LocalPlayerIndex The local player whose row is changed, 0 is the primary player */
 	UFUNCTION(BlueprintCallable, Category = "C++")
-	void SetCurrentRowByTag(FPlayerTag NewRowPlayerTag);
+	void SetCurrentRowByTag(FPlayerTag NewRowPlayerTag, int32 LocalPlayerIndex = 0);
 
-	/* Delegate for informing row data changed */
+	/* Delegate for informing row data changed, is the Blueprint adapter of FPSEventBus::RowChanged */
 	UPROPERTY(BlueprintAssignable, Transient, Category = "C++")
 	FCurrentRowDataChanged OnCurrentRowDataChanged;
 
-	/* Delegate for informing save game file is loaded/created if empty */
+	/* Delegate for informing save game file is loaded/created if empty, is the Blueprint adapter of FPSEventBus::Initialized */
 	UPROPERTY(BlueprintAssignable, Transient, Category = "C++")
 	FPSOnInitialize OnInitialize;
 
+	/* Delegate for informing initialization failed, e.g. the data asset is not loaded, is the Blueprint adapter of FPSEventBus::Initialized */
+	UPROPERTY(BlueprintAssignable, Transient, Category = "C++")
+	FPSOnInitialize OnInitializeFailed;
+
+	/* Delegate for informing achieved points of a level changed, is the Blueprint adapter of FPSEventBus::ProgressChanged */
+	UPROPERTY(BlueprintAssignable, Transient, Category = "C++")
+	FPSOnProgressChanged OnProgressChanged;
+
+	/* Delegate for informing a level is unlocked, is the Blueprint adapter of FPSEventBus::LevelUnlocked */
+	UPROPERTY(BlueprintAssignable, Transient, Category = "C++")
+	FPSOnLevelUnlocked OnLevelUnlocked;
+
+	/** Returns native progression events, C++ listeners should subscribe here instead of the dynamic delegates */
+	FORCEINLINE FPSEventBus& GetEventBus() { return EventBusInternal; }
+
 	/** Returns the data asset that contains all the assets of Progression System game feature.
 	 * @see UPSWorldSubsystem::PSDataAssetInternal. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "C++")
 	const class UPSDataAsset* GetPSDataAsset() const;
 
+	/** Returns the data asset of this world's progression, is checked. */
+	const class UPSDataAsset& GetPSDataAssetChecked() const;
+
+	/** Returns the pool manager of this world, is checked, so objects of other worlds (e.g. PIE instances) are never taken. */
+	class UPoolManagerSubsystem& GetPoolManagerChecked() const;
+
+	/** Returns the current game state, is updated by game state changes, so consumers don't look up the game state on each refresh. */
+	FORCEINLINE ECurrentGameState GetCurrentGameState() const { return CurrentGameStateInternal; }
+
+	/** Returns the settings widget, is found once and kept, is null if there are no settings in this game. */
+	class USettingsWidget* GetSettingsWidget() const;
+
+	/** Returns the amount of local players which progression is tracked */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE int32 GetLocalPlayersNum() const { return LocalPlayersInternal.Num(); }
+
+	/** Returns the progression of the local player, is empty if the player is not tracked */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	const FPSLocalPlayerData& GetLocalPlayerData(int32 LocalPlayerIndex = 0) const;
+
+	/** Returns the index of the local player that owns given object (widget, component, pawn or controller), 0 if it's not owned by any local player */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	int32 GetLocalPlayerIndex(const UObject* Object) const;
+
 	/** Returns a progression System component reference */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FORCEINLINE class UPSHUDComponent* GetProgressionSystemHUDComponent() const { return PSHUDComponentInternal; }
+	FORCEINLINE class UPSHUDComponent* GetProgressionSystemHUDComponent(int32 LocalPlayerIndex = 0) const { return GetLocalPlayerData(LocalPlayerIndex).HUDComponent; }
 
 	/** Returns a current progression row name */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FORCEINLINE FName GetCurrentRowName() const { return CurrentRowNameInternal; }
+	FORCEINLINE FName GetCurrentRowName(int32 LocalPlayerIndex = 0) const { return GetLocalPlayerData(LocalPlayerIndex).CurrentRowName; }
 
 	/** Returns a current progression save game data */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FORCEINLINE class UPSSaveGameData* GetCurrentSaveGameData() const { return SaveGameDataInternal; }
+	FORCEINLINE class UPSSaveGameData* GetCurrentSaveGameData(int32 LocalPlayerIndex = 0) const { return GetLocalPlayerData(LocalPlayerIndex).SaveGameData; }
 
 	/** Returns first save to disk row data */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	FName GetFirstSaveToDiskRowName() const;
+	FName GetFirstSaveToDiskRowName(int32 LocalPlayerIndex = 0) const;
 
 	/** Returns a current save to disk row by name */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	const FPSSaveToDiskData& GetCurrentSaveToDiskRowByName() const;
+	const FPSSaveToDiskData& GetCurrentSaveToDiskRowByName(int32 LocalPlayerIndex = 0) const;
 
 	/** Returns a current progression row settings data row by name */
 	UFUNCTION(BlueprintPure, Category = "C++")
-	const FPSRowData& GetCurrentProgressionSettingsRowByName() const;
+	const FPSRowData& GetCurrentProgressionSettingsRowByName(int32 LocalPlayerIndex = 0) const;
+
+	/** Returns settings of all progression rows, are owned by the game instance subsystem and loaded from the data table once per game instance */
+	const TMap<FName, FPSRowData>& GetProgressionSettingsData() const;
+
+	/** Returns the subsystem that keeps settings and save profiles between worlds, is null if this world has no game instance */
+	class UPSGameInstanceSubsystem* GetGameInstanceSubsystem() const;
+
+	/** Returns the last published immutable progression of all local players, is never null once the subsystem is initialized.
+	 * The returned snapshot is kept alive by its pointer even after a newer one is published. */
+	FPSProgressionSnapshotPtr GetProgressionSnapshot() const;
 
-	/** Set the progression system component */
+	/** Returns the publisher of progression snapshots, worker tasks keep it to read the progression without accessing this subsystem. */
+	FORCEINLINE FPSSnapshotPublisherRef GetProgressionSnapshotPublisher() const { return ProgressionSnapshotPublisherInternal; }
+
+	/** Set the progression system component of the local player that owns it, loads the save profile of that player if it's not loaded yet */
 	UFUNCTION(BlueprintCallable, Category = "C++")
 	void SetHUDComponent(class UPSHUDComponent* MyHUDComponent);
 
-	/** Set the progression system spot component */
+	/** Registers the spot by the player tag of its character, is called once the spot is initialized or streamed in.
+	 * The spot becomes current right away if its character is already chosen by a local player. */
 	UFUNCTION(BlueprintCallable, Category = "C++")
 	void RegisterSpotComponent(class UPSSpotComponent* MyHUDComponent);
 
-	/** Set the progression system spot component */
+	/** Removes the spot once it's unregistered or streamed out, so no stale spots are kept. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void UnregisterSpotComponent(class UPSSpotComponent* SpotComponent);
+
+	/** Returns the registered spot of given character, is null if the spot is not streamed in. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	class UPSSpotComponent* FindSpotComponent(const FPlayerTag& PlayerTag) const;
+
+	/** Set the progression system spot component as current for all local players whose character is on this spot */
 	UFUNCTION(BlueprintCallable, Category = "C++")
 	void SetCurrentSpotComponent(class UPSSpotComponent* MyHUDComponent);
 
-	/** Saves the progression to the local files */
+	/** Returns the save slot of the local player in this world: the base slot name with the per-world and per-player suffixes if any.
+	 * The primary player keeps the base slot, so the save of a single player game is the same.
+	 * @see UPSWorldSubsystem::SaveSlotSuffixInternal
+	 * @see UPSWorldSubsystem::bAppendPIEInstanceToSaveSlotInternal */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FString GetSaveSlotName(int32 LocalPlayerIndex = 0) const;
+
+	/** Sets the suffix of the save slot of this world, so parallel worlds (e.g. automation) don't share the same save file.
+	 * Has to be set before the save game is loaded. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SetSaveSlotSuffix(const FString& NewSaveSlotSuffix);
+
+	/** Saves the progression of the local player to the local files */
 	UFUNCTION()
-	void SaveDataAsync();
+	void SaveDataAsync(int32 LocalPlayerIndex = 0);
+
+	/** Queues the end-game result of the local player, results of all local players are saved at once on the next flush */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void QueueEndGameResult(int32 LocalPlayerIndex, EEndGameState EndGameState);
+
+	/** Adds points earned by an in-match event (e.g. kill, pickup or survival time) to the local player, is committed to the save at match end.
+	 * In network games the server owns the progression: points of the listen server player are forwarded to its replication component,
+	 * points posted on clients are only displayed and are never sent, the server adds progress of remote players by UPSReplicationSubsystem::AddMatchProgress.
+	 * Is lock-free and safe to call from any thread, posted points are reduced once per frame on the game thread. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void PostMatchProgress(int32 LocalPlayerIndex, float Points);
+
+	/** Returns the accumulator of in-match progress, worker tasks keep it to post points without accessing this subsystem. */
+	FORCEINLINE FPSProgressAccumulatorRef GetMatchProgressAccumulator() const { return MatchProgressAccumulatorInternal; }
+
+	/** Returns points earned by in-match events of the local player since the match started, are not saved yet. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	FORCEINLINE float GetMatchProgress(int32 LocalPlayerIndex = 0) const { return GetLocalPlayerData(LocalPlayerIndex).MatchProgress; }
+
+	/** Sets the component that replicates the progression of the local player owning it, the server becomes the authority of this player's progression.
+	 * Uploads the saved progression to the server if the save is already loaded. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SetReplicationComponent(class UPSReplicationComponent* ReplicationComponent);
 
-	/** Removes all saved data of the Progression system and creates a new empty data */
+	/** Removes the replication component from the local player it was set for, the progression is applied locally again. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void RemoveReplicationComponent(const class UPSReplicationComponent* ReplicationComponent);
+
+	/** Returns true if the progression of the local player is owned by the server, so end-game results are not applied locally. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	bool IsServerAuthoritative(int32 LocalPlayerIndex = 0) const;
+
+	/** Writes the row received from the server to the save profile of the local player, it's saved on the next flush. */
+	void ApplyReplicatedRow(int32 LocalPlayerIndex, FName RowName, const FPSSaveToDiskData& NewSaveToDiskData);
+
+	/** Removes all saved data of the Progression system of all local players and creates a new empty data */
 	UFUNCTION(BlueprintCallable, Category = "C++")
 	void ResetSaveGameData();
 
-	/** Unlocks all levels of the Progression System */
+	/** Unlocks all levels of the Progression System for all local players */
 	UFUNCTION(BlueprintCallable, Category = "C++")
 	void UnlockAllLevels();
 
@@ -103,9 +237,90 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="C++")
 	float GetDifficultyMultiplier() const;
 
-	/** Returns current spot component returns null if spot is not found */
+	/** Returns the current progression row of the local player, is used by save profiles of the core module. */
+	virtual FName GetProgressionRowName(int32 LocalPlayerIndex) const override { return GetCurrentRowName(LocalPlayerIndex); }
+
+	/** Returns settings of the current progression row of the local player, is used by save profiles of the core module. */
+	virtual const FPSRowData& GetProgressionRowSettings(int32 LocalPlayerIndex) const override { return GetCurrentProgressionSettingsRowByName(LocalPlayerIndex); }
+
+	/** Returns the difficulty multiplier of end-game rewards, is used by save profiles of the core module. */
+	virtual float GetProgressionRewardMultiplier() const override { return GetDifficultyMultiplier(); }
+
+	/** Returns native progression events, is used by save profiles of the core module. */
+	virtual FPSEventBus& GetProgressionEventBus() override { return EventBusInternal; }
+
+	/** Sets the replication component of the local player, is used by replication components of the core module. */
+	virtual void SetProgressionReplication(class UPSReplicationComponent* ReplicationComponent) override { SetReplicationComponent(ReplicationComponent); }
+
+	/** Removes the replication component of the local player, is used by replication components of the core module. */
+	virtual void RemoveProgressionReplication(const class UPSReplicationComponent* ReplicationComponent) override { RemoveReplicationComponent(ReplicationComponent); }
+
+	/** Writes the row received from the server to the save profile of the local player, is used by replication components of the core module. */
+	virtual void ApplyReplicatedProgressionRow(const class UPSReplicationComponent* ReplicationComponent, FName RowName, const FPSSaveToDiskData& NewSaveToDiskData) override { ApplyReplicatedRow(GetLocalPlayerIndex(ReplicationComponent), RowName, NewSaveToDiskData); }
+
+	/** Returns current spot component of the local player returns null if spot is not found */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="C++")
+	UPSSpotComponent* GetCurrentSpot(int32 LocalPlayerIndex = 0) const;
+
+	/** Returns the local player whose character is on given spot, 0 if the spot is not used by any local player */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="C++")
-	UPSSpotComponent* GetCurrentSpot() const;
+	int32 GetSpotLocalPlayerIndex(const UPSSpotComponent* SpotComponent) const;
+
+	/** Returns the usage of the star widgets pool, is kept by subsystem since menu widgets are re-created while the pool is reused */
+	FORCEINLINE FPSPoolUsageData& GetStarWidgetsPoolUsage() { return StarWidgetsPoolUsageInternal; }
+
+	/** Destroys free pooled objects of the class above the allowed amount, the rest are kept in the pool to be reused.
+	 * @param ObjectClass The class of pooled objects.
+	 * @param MaxPooledNum The amount of free objects to keep.
+	 * @param PoolUsage The usage of this pool, destroyed objects are removed from it. */
+	void TrimPool(const UClass* ObjectClass, int32 MaxPooledNum, FPSPoolUsageData& PoolUsage);
+
+	/** Returns the transforms of all stars of the given row, is computed once and cached until row settings are changed
+	 * @param RowName The progression row name to get layout for.
+	 * @param StarsNum The amount of stars in the row. */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	const FPSStarsLayoutData& GetStarsLayout(FName RowName, int32 StarsNum);
+
+	/** Returns the cached presentation of the given row by the save profile of the local player, is empty if the row is not found */
+	UFUNCTION(BlueprintPure, Category="C++")
+	const FPSPresentationData& GetPresentationData(FName RowName, int32 LocalPlayerIndex = 0) const;
+
+	/** Returns the presentation currently displayed for the current row of the local player, it's the cached one unless count-up is playing */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	const FPSPresentationData& GetDisplayedPresentationData(int32 LocalPlayerIndex = 0);
+
+	/** Recomputes the presentation of all rows of the local player, is called after the save is loaded or reset */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	void RebuildPresentationCache(int32 LocalPlayerIndex = 0);
+
+	/** Recomputes the presentation only of rows changed since the last update, is called after each save */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	void UpdatePresentationCache(int32 LocalPlayerIndex = 0);
+
+	/** Marks progression consumers to be refreshed, all marks are coalesced and flushed once after actors tick in this frame
+	 * @param DirtyFlags Consumers to refresh */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	void MarkProgressionDirty(UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/ProgressionSystemRuntime.EPSDirtyFlags")) int32 DirtyFlags);
+	FORCEINLINE void MarkProgressionDirty(EPSDirtyFlags DirtyFlags) { MarkProgressionDirty(static_cast<int32>(DirtyFlags)); }
+
+	/** Starts the count-up animation that fills earned stars in sequence, both in the menu widget and star actors.
+	 * Is skipped if Instant Character Switch setting is enabled, so stars are updated instantly.
+	 * @param FromPoints The level progression displayed before points were earned.
+	 * @param LocalPlayerIndex The local player whose stars are counted up, star actors display the primary player. */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	void PlayStarsCountUp(float FromPoints, int32 LocalPlayerIndex = 0);
+
+	/** Stops the count-up animation of all local players, stars are displaying the saved level progression */
+	UFUNCTION(BlueprintCallable, Category="C++")
+	void StopStarsCountUp();
+
+	/** Returns true if the count-up animation of the local player is playing */
+	UFUNCTION(BlueprintPure, Category="C++")
+	FORCEINLINE bool IsStarsCountUpPlaying(int32 LocalPlayerIndex = 0) const { return StarsCountUpInternal.IsPlaying(LocalPlayerIndex); }
+
+	/** Returns the level progression of the current row of the local player displayed by stars, is behind the saved one while count-up is playing */
+	UFUNCTION(BlueprintPure, Category="C++")
+	float GetDisplayedLevelProgression(int32 LocalPlayerIndex = 0) const;
 
 protected:
 	/** Contains all the assets and tweaks of Progression System game feature.
@@ -115,38 +330,139 @@ protected:
 	UPROPERTY(Config, VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression System Data Asset"))
 	TSoftObjectPtr<const class UPSDataAsset> PSDataAssetInternal;
 
-	/** Progression System component reference*/
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression System HUD Component"))
-	TObjectPtr<class UPSHUDComponent> PSHUDComponentInternal = nullptr;
+	/** How often the significance of star actors is evaluated, in seconds. 0 disables animations throttling.
+	 * Can be overridden per platform in the platform ProgressionSystem.ini */
+	UPROPERTY(Config, VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Stars Significance Update Interval"))
+	float StarsSignificanceUpdateIntervalInternal = 0.25f;
 
-	/** Progression System Array of Spot Components */
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression System Spot Array"))
-	TArray<class UPSSpotComponent*> PSSpotComponentArrayInternal;
+	/** Maximum amount of visible star actors animated at full frame rate, the rest visible stars are animated at reduced rate */
+	UPROPERTY(Config, VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Max Significant Stars"))
+	int32 MaxSignificantStarsInternal = 10;
 
-	/** Progression System Spot Component reference*/
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Progression System Spot Component"))
-	TObjectPtr<class UPSSpotComponent> PSCurrentSpotComponentInternal = nullptr;
+	/** Distance from the camera after which star actors are considered as low significant */
+	UPROPERTY(Config, VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Stars Significance Distance"))
+	float StarsSignificanceDistanceInternal = 3000.f;
 
-	/** Store the current save game instance
-	 * Contains the FPSSaveToDiskData which has actual data from save file */
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Save Game Data Internal"))
-	TObjectPtr<class UPSSaveGameData> SaveGameDataInternal = nullptr;
+	/** Tick interval of low significant star actors, in seconds */
+	UPROPERTY(Config, VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Reduced Stars Tick Interval"))
+	float ReducedStarsTickIntervalInternal = 0.1f;
 
-	/** Store default values from the progression settings data table cached once on load and never changed later */
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Save Game Instance"))
-	TMap<FName, FPSRowData> ProgressionSettingsDataInternal;
+	/** If true, star actors which are not rendered freeze on their current pose, otherwise are animated at reduced rate */
+	UPROPERTY(Config, VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Freeze Not Rendered Stars"))
+	bool bFreezeNotRenderedStarsInternal = true;
 
-	/** Store the current row name */
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Current Row Name"))
-	FName CurrentRowNameInternal = NAME_None;
+	/** If true, the PIE instance index is appended to the save slot of each PIE world except the first one,
+	 * so several PIE clients don't overwrite each other's progression */
+	UPROPERTY(Config, VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Append PIE Instance To Save Slot"))
+	bool bAppendPIEInstanceToSaveSlotInternal = true;
+
+	/** Optional suffix of the save slot of this world, is empty by default to use the shared save slot */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Save Slot Suffix"))
+	FString SaveSlotSuffixInternal;
+
+	/** Registered spots by the player tag of their character, spots are added and removed while the level is streamed.
+	 * Is weak, so a spot destroyed without unregistering is never accessed. */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Spot Components By Player Tag"))
+	TMap<FPlayerTag, TWeakObjectPtr<class UPSSpotComponent>> SpotComponentsByPlayerTagInternal;
+
+	/** Progression of each local player by the local player index: current row, spot, HUD component and save profile.
+	 * Has one element in a single player game, few elements in split-screen */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Local Players"))
+	TArray<FPSLocalPlayerData> LocalPlayersInternal;
+
+	/** The subsystem that owns settings and save profiles for the whole game instance, is cached on the first use */
+	mutable TWeakObjectPtr<class UPSGameInstanceSubsystem> GameInstanceSubsystemInternal = nullptr;
+
+	/** The settings widget, is cached on the first use */
+	mutable TWeakObjectPtr<class USettingsWidget> SettingsWidgetInternal = nullptr;
+
+	/** The current game state, is taken once on initialization and then updated by game state changes */
+	ECurrentGameState CurrentGameStateInternal = static_cast<ECurrentGameState>(0);
+
+	/** Star actors currently taken from the pool for the current spot */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Actors"))
+	TArray<TObjectPtr<class APSStarActor>> StarActorsInternal;
+
+	/** Usage of the star actors pool, is kept between clean-ups to bound the pool size */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Actors Pool Usage"))
+	FPSPoolUsageData StarActorsPoolUsageInternal;
+
+	/** Usage of the star widgets pool, is kept between menu widgets to bound the pool size */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Widgets Pool Usage"))
+	FPSPoolUsageData StarWidgetsPoolUsageInternal;
+
+	/** Throttles animations of star actors by their significance for cameras of all local players */
+	FPSStarsSignificance StarsSignificanceInternal;
+
+	/** Cached transforms of the star actors per progression row */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Stars Layouts"))
+	TMap<FName, FPSStarsLayoutData> StarsLayoutsInternal;
+
+	/** Progression row names by the character tag, to find the row of the switched character without iterating all rows */
+	TMap<FPlayerTag, FName> RowNamesByPlayerTagInternal;
+
+	/** Publishes the progression snapshot, it's replaced as a whole and never modified, so readers on other threads only copy the pointer without locks */
+	FPSSnapshotPublisherRef ProgressionSnapshotPublisherInternal = MakeShared<FPSSnapshotPublisher, ESPMode::ThreadSafe>();
+
+	/** Version of the last published snapshot */
+	uint64 ProgressionSnapshotVersionInternal = 0;
+
+	/** Copies the progression of all local players to the new immutable snapshot and publishes it, is called on the game thread after each committed change.
+	 * @param bIsRowsChanged False if only current rows are changed, so rows and settings of the previous snapshot are shared instead of copied. */
+	void PublishProgressionSnapshot(bool bIsRowsChanged = true);
+
+	/** Consumers marked to be refreshed on the next flush */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Dirty Flags", Bitmask, BitmaskEnum = "/Script/ProgressionSystemRuntime.EPSDirtyFlags"))
+	int32 DirtyFlagsInternal = 0;
+
+	/** Native progression events, dynamic delegates of this subsystem are subscribed to it as Blueprint adapters */
+	FPSEventBus EventBusInternal;
+
+	/** Handle of the flush registered while any consumer is dirty */
+	FDelegateHandle DirtyFlushHandleInternal;
+
+	/** Points posted by in-match events from any thread, are reduced to local players once per frame */
+	FPSProgressAccumulatorRef MatchProgressAccumulatorInternal = MakeShared<FPSProgressAccumulator, ESPMode::ThreadSafe>();
+
+	/** Handle of the per-frame reduction registered while the match is running */
+	FDelegateHandle MatchProgressReduceHandleInternal;
+
+	/** The count-up animation of stars of all local players */
+	FPSStarsCountUp StarsCountUpInternal;
 
 	/** Array of pool actors handlers which should be released */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Pool Actors Handlers"))
 	TArray<FPoolObjectHandle> PoolActorHandlersInternal;
 
-	/** Store the material for dynamic progress material fill for a star actor */
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Dynamic Progress Material"))
-	TObjectPtr<class UMaterialInstanceDynamic> StarDynamicProgressMaterial = nullptr;
+	/** Star actors taken from the pool only to spawn them during initialization, are returned right away */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Prewarm Star Handles"))
+	TArray<FPoolObjectHandle> PrewarmStarHandlesInternal;
+
+	/** Initialization stages that are not finished yet */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Pending Init Stages", Bitmask, BitmaskEnum = "/Script/ProgressionSystemRuntime.EPSInitStage"))
+	int32 PendingInitStagesInternal = 0;
+
+	/** Duration of each finished initialization stage in seconds, None is the total time to ready */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Init Stage Durations"))
+	TMap<EPSInitStage, float> InitStageDurationsInternal;
+
+	/** Time when each running initialization stage was started, None is the start of initialization */
+	TMap<EPSInitStage, double> InitStageStartTimesInternal;
+
+	/** Is set once all initialization stages are finished */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Is Progression Ready"))
+	bool bIsProgressionReadyInternal = false;
+
+	/** Is set once any initialization stage failed, other stages are not waited for */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Is Progression Failed"))
+	bool bIsProgressionFailedInternal = false;
+
+	/** The save of the primary player that is loaded before other stages are finished, is applied once all of them are finished */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Pending Primary Save Game"))
+	TObjectPtr<class USaveGame> PendingPrimarySaveGameInternal = nullptr;
+
+	/** Handle of the async loading of the data asset, keeps it loading */
+	TSharedPtr<struct FStreamableHandle> DataAssetLoadHandleInternal;
 
 	/*********************************************************************************************
 	* Protected functions
@@ -157,6 +473,9 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
 	void OnInitialized();
 	
+	/** Subscribes Blueprint adapters and own handlers to the progression events. */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
 	/** Called when world is ready to start gameplay before the game mode transitions to the correct state and call BeginPlay on all actors */
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 
@@ -175,9 +494,23 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
 	void OnGameStateChanged(ECurrentGameState CurrentGameState);
 
-	/** Set first element as current active */
+	/** Set first element as current active for the local player */
 	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
-	void SetFirstElementAsCurrent();
+	void SetFirstElementAsCurrent(int32 LocalPlayerIndex = 0);
+
+	/** Returns the progression of the local player, adds it if the player is not tracked yet */
+	FPSLocalPlayerData& GetOrAddLocalPlayerData(int32 LocalPlayerIndex);
+
+	/** Returns the character possessed by the local player, is null if the player has no character */
+	class APlayerCharacter* GetLocalPlayerCharacter(int32 LocalPlayerIndex) const;
+
+	/** Starts loading the save profile of the local player, does nothing if it's already loaded or being loaded */
+	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
+	void LoadLocalPlayerSave(int32 LocalPlayerIndex);
+
+	/** Applies queued end-game results of all local players and saves each changed profile once */
+	UFUNCTION(BlueprintCallable, Category="C++", meta=(BlueprintProtected))
+	void ApplyEndGameResults();
 
 	/** Updates the stars actors for a spot by Spawning/adding the stars actors for a spot */
 	UFUNCTION(BlueprintCallable, Category="C++", meta=(BlueprintProtected))
@@ -190,15 +523,84 @@ protected:
 	UFUNCTION(BlueprintCallable, Category= "C++")
 	void OnTakeActorsFromPoolCompleted(const TArray<FPoolObjectData>& CreatedObjects);
 
+	/** Registers the star actor received from the pool to measure how many of them were reused instead of spawned. */
+	void RegisterTakenStarActor(const class APSStarActor& StarActor);
+
+	/** Computes the presentation of the row for given level progression
+	 * @param RowName The progression row to compute presentation for
+	 * @param LevelProgression Achieved points of the level to display
+	 * @param SaveGameData The save profile to read the lock state from
+	 * @param OutPresentationData Presentation to fill, its allocations are reused */
+	void MakePresentationData(FName RowName, float LevelProgression, const class UPSSaveGameData* SaveGameData, FPSPresentationData& OutPresentationData) const;
+
+	/** Marks the row of the local player to be recomputed in the presentation cache on the next save, is called on each progression change and unlock */
+	void MarkPresentationRowDirty(FName RowName, int32 LocalPlayerIndex);
+
+	/** Refreshes all dirty consumers at once, is called after actors tick in the frame they were marked */
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Refreshes all dirty consumers and clears the flags */
+	UFUNCTION(BlueprintCallable, Category="C++", meta=(BlueprintProtected))
+	void FlushDirtyProgression();
+
+	/** Starts accumulating in-match progress from zero, the posted points are reduced once per frame until the match is committed. */
+	void StartMatchProgress();
+
+	/** Stops the per-frame reduction and discards in-match progress that is not committed. */
+	void StopMatchProgress();
+
+	/** Reduces in-match progress once per frame, is called after actors tick. */
+	void OnMatchProgressPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Adds points posted since the last reduction to the in-match progress of each local player. */
+	void ReduceMatchProgress();
+
+	/** Applies the displayed level progression of the primary player to the fill of each star actor */
+	UFUNCTION(BlueprintCallable, Category="C++", meta=(BlueprintProtected))
+	void UpdateStarActorsFills();
+
+	/** Applies the count-up animation of the local player to its stars, both the widget and actors read the same displayed progression, so they are always in sync */
+	void OnStarsCountUpUpdated(int32 LocalPlayerIndex);
+
+	/** Scores each star actor by visibility and distance to cameras of all local players and throttles animations of low significant stars */
+	UFUNCTION(BlueprintCallable, Category="C++", meta=(BlueprintProtected))
+	void UpdateStarsSignificance();
+
 	/** Triggers when a spot is loaded */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="C++", meta=(BlueprintProtected))
-	void OnSpotComponentLoad(class UPSSpotComponent* SpotComponent);
+	void OnSpotComponentLoad(class UPSSpotComponent* SpotComponent, int32 LocalPlayerIndex);
 
-	/** Is called from AsyncLoadGameFromSlot once Save Game is loaded, or null if it failed to load. */
+	/** Is called from AsyncLoadGameFromSlot once Save Game is loaded, or null if it failed to load.
+	 * The user index is the index of the local player whose save profile is loaded.
+	 * The save of the primary player is kept until all initialization stages are finished. */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
 	void OnAsyncLoadGameFromSlotCompleted(const FString& SlotName, int32 UserIndex, class USaveGame* SaveGame);
 
-	/** Is called to update the stars actors and in widgets when finish to save date in save file */
+	/** Sets the loaded save as the profile of the local player, creates a new one if it failed to load. */
+	void ApplyLoadedSaveGame(const FString& SlotName, int32 LocalPlayerIndex, class USaveGame* SaveGame);
+
+	/** Starts all initialization stages that don't depend on each other: the data asset and the primary save are loaded concurrently. */
+	void StartInitialization();
+
+	/** Remembers the start time of the stage and marks it as pending. */
+	void StartInitStage(EPSInitStage Stage);
+
+	/** Reports the duration of the stage and finishes initialization once all stages are finished. */
+	void FinishInitStage(EPSInitStage Stage);
+
+	/** Is called once the data asset is loaded, starts stages that depend on it. */
+	void OnDataAssetLoaded();
+
+	/** Spawns star actors of the largest row to the pool, so the first stars are displayed without spawning. */
+	void PrewarmStarsPool();
+
+	/** Applies the primary save and broadcasts the single ready event once all stages are finished. */
+	void FinishInitialization();
+
+	/** Stops initialization because of the failed stage and broadcasts the failed result, so listeners don't wait for the ready event forever. */
+	void FailInitialization(EPSInitStage FailedStage);
+
+	/** Is called to update the stars actors and in widgets when finish to save date in save file, the update is deferred to the flush */
 	UFUNCTION(BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
 	void UpdateProgressionUI();
 };
@@ -3,13 +3,14 @@
 #pragma once
 
 #include "GameFramework/Actor.h"
+#include "Data/PSContext.h"
 #include "PSStarActor.generated.h"
 
 enum class ECurrentGameState : uint8;
 enum class EPSStarActorState : uint8;
 
 UCLASS()
-class PROGRESSIONSYSTEMRUNTIME_API APSStarActor : public AActor
+class PROGRESSIONSYSTEMRUNTIME_API APSStarActor : public AActor, public TPSContextOwner<APSStarActor>
 {
 	GENERATED_BODY()
 
@@ -29,23 +30,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "C++")
 	void SetStartTimeMenuStars();
 
-	/** Automatically set the transform and location of actor 
-	 * when a Star actor is initialized
-	* @param PreviousActorLocation Previous star actor location reference
-	*/
+	/** Sets the transform of actor when a Star actor is initialized
+	 * @param StarTransform Finished transform computed by the stars layout of the current row
+	 */
 	UFUNCTION(BlueprintCallable, Category = "C++")
-	void OnInitialized(const FVector& PreviousActorLocation);
-
-	/** Updates star actors Mesh material to the Locked Star, Unlocked or partially achieved
-	 * 0 - locked star material
-	 * 1 - unlocked star material
-	 * between 0-1 - partially unlocked material (dynamic) e.g. 0.5  
-	 * @param StarDynamicProgressMaterial a Dynamic fill material of a star (e.g. 0.5)
-	 * @param AmountOfStars The number of stars to be added on top of the character
+	void OnInitialized(const FTransform& StarTransform);
+
+	/** Updates star actor fill and lock values through custom primitive data of its mesh, the material is never swapped
+	 * 0 - empty star
+	 * 1 - fully filled star
+	 * between 0-1 - partially filled star e.g. 0.5, each star has its own independent fill
+	 * @param AmountOfStars The fill amount of this star
 	 * @param StarActorState Desired state of the star actor.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "C++")
-	void UpdateStarActorMeshMaterial(class UMaterialInstanceDynamic* StarDynamicProgressMaterial, float AmountOfStars, EPSStarActorState StarActorState);
+	void UpdateStarActorMeshMaterial(float AmountOfStars, EPSStarActorState StarActorState);
+
+	/** Throttles the star animations depending on the star significance
+	 * @param TickInterval How often the star is animated, 0 means every frame
+	 * @param bShouldFreeze If true, the star stays on its current pose until it becomes significant again
+	 */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SetAnimationThrottling(float TickInterval, bool bShouldFreeze);
 
 protected:
 	// Called when the game starts or when spawned
@@ -4,36 +4,91 @@
 
 #include "Blueprint/UserWidget.h"
 #include "PoolManagerTypes.h"
+#include "Data/PSTypes.h"
+#include "Data/PSContext.h"
 #include "PSMenuWidget.generated.h"
 
 /**
  * Widget to display the progression as stars in the main menu.
  */
 UCLASS()
-class PROGRESSIONSYSTEMRUNTIME_API UPSMenuWidget : public UUserWidget
+class PROGRESSIONSYSTEMRUNTIME_API UPSMenuWidget : public UUserWidget, public TPSContextOwner<UPSMenuWidget>
 {
 	GENERATED_BODY()
 
 public:
 	/**
 	 * Dynamically populates a Horizontal Box with images representing unlocked and locked progression icons.
+	 * If the level requires more points than allowed to display, the stars are compacted and the counter is shown.
+	 * Star widgets are kept between calls, only the differences in count, images and percentages are applied.
 	 * @param AmountOfUnlockedPoints The number of images (unlocked-icon as images) to be displayed 
 	 * @param AmountOfLockedPoints The number of images (locked-icon as images) to be displayed
 	 */
 	UFUNCTION(BlueprintCallable, Category= "C++")
 	void AddImagesToHorizontalBox(float AmountOfUnlockedPoints, float AmountOfLockedPoints, float MaxLevelPoints);
 
+	/** Displays the precomputed presentation of the progression row: star fills and the counter.
+	 * Star widgets are kept between calls, only the differences in count, images and percentages are applied. */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void ApplyPresentationData(const FPSPresentationData& PresentationData);
+
+	/** Returns all star widgets to the pool, the pool is kept to be reused by the next menu widget unless it grew above allowed size */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void ReleaseStarWidgets();
+
+	/** Shows or hides the widget.
+	 * Is hidden instead of collapsed since it's the root widget in the viewport, so no sibling depends on its layout and only its visibility is invalidated. */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void SetMenuWidgetShown(bool bIsShown);
+
+	/** Moves the widget to its end-game or main menu position by the padding, the same as the designer laid it out.
+	 * The layout is invalidated only when the position is actually changed, so once per end-game screen. */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void SetEndGamePosition(bool bIsEndGame);
+
 	/*********************************************************************************************
 	 * Protected functions
 	 ********************************************************************************************* */
 protected:
-	// Horizontal Box widget for storing stars
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidget))
+	// Horizontal Box widget for storing stars, is not required if the Star Bar is used instead
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidgetOptional))
 	TObjectPtr<class UHorizontalBox> HorizontalBox = nullptr;
 
-	/** Array of pool handlers which should be released */
+	/** Optional native star bar that paints all stars at once, if set it replaces the Horizontal Box of pooled star widgets */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidgetOptional))
+	TObjectPtr<class UPSStarBarWidget> StarBar = nullptr;
+
+	/** Optional text to display the progression counter (e.g. 42/100) when there are more points than stars to display */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidgetOptional))
+	TObjectPtr<class UTextBlock> StarsCounterText = nullptr;
+
+	/** Padding of the widget in the end-game screen, the main menu has no padding */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "C++", meta = (BlueprintProtected, DisplayName = "End Game Padding"))
+	FMargin EndGamePaddingInternal = FMargin(0.f, 800.f, 0.f, 0.f);
+
+	/** Array of pool handlers which should be released, includes handles of requested widgets that are not taken yet */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Pool Widget Handlers"))
 	TArray<FPoolObjectHandle> PoolWidgetHandlersInternal;
+
+	/** Star widgets added to the Horizontal Box in display order, are kept between refreshes */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Widgets"))
+	TArray<TObjectPtr<class UPSStarWidget>> StarWidgetsInternal;
+
+	/** Pool handles of star widgets, is parallel to StarWidgetsInternal */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Widget Handles"))
+	TArray<FPoolObjectHandle> StarWidgetHandlesInternal;
+
+	/** Fills currently displayed by each star widget, is parallel to StarWidgetsInternal. 0 is the locked star, 1 is the fully unlocked star */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Displayed Star Fills"))
+	TArray<float> DisplayedStarFillsInternal;
+
+	/** Fills that should be displayed, star widgets are added or removed to match its amount */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Desired Star Fills"))
+	TArray<float> DesiredStarFillsInternal;
+
+	/** Amount of requested star widgets which are not taken from the pool yet */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Pending Star Widgets Num"))
+	int32 PendingStarWidgetsNumInternal = 0;
 	
 	/** Called after the underlying slate widget is constructed.
 	 * May be called multiple times due to adding and removing from the hierarchy. */
@@ -51,27 +106,45 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "C++", meta = (BlueprintProtected))
 	void OnEndGameStateChanged(EEndGameState EndGameState);
 
+	/** Is called when requested star widgets are taken from the pool, appends them to the Horizontal Box and applies desired fills.
+	 * @param CreatedObjects Objects received from Pool Manager which contain the references to Star Widgets
+	 */
+	UFUNCTION(BlueprintCallable, Category= "C++")
+	void OnTakeStarWidgetsCompleted(const TArray<FPoolObjectData>& CreatedObjects);
+
 	/**
 	 * Dynamically populates a Horizontal Box with images representing unlocked and locked progression icons.
-	* @param CreatedObjects - Handles of objects from Pool Manager
-	* @param AmountOfUnlockedPoints The number of images (unlocked-icon as images) to be displayed 
+	 * Is kept for existing callers: given widgets are adopted by this widget and the stars are diffed as by AddImagesToHorizontalBox.
+	 * @param CreatedObjects - Handles of objects from Pool Manager
+	 * @param AmountOfUnlockedPoints The number of images (unlocked-icon as images) to be displayed 
 	 * @param AmountOfLockedPoints The number of images (locked-icon as images) to be displayed
 	 */
-	UFUNCTION(BlueprintCallable, Category= "C++")
+	UFUNCTION(BlueprintCallable, Category= "C++", meta = (DeprecatedFunction, DeprecationMessage = "Call AddImagesToHorizontalBox, star widgets are taken from the pool by this widget"))
 	void OnTakeFromPoolCompleted(const TArray<FPoolObjectData>& CreatedObjects, float AmountOfUnlockedPoints, float AmountOfLockedPoints, float MaxLevelPoints);
-	
-	/** Updates star images icon to locked/unlocked according to input amounnt
-	 * @param CreatedData Object received from Pool Manager which contains the reference to Start Widget 
-	 * @param AmountOfUnlockedStars Amount of icons to be switched to Unlocked stars.
-	 * @param AmountOfLockedStars Amount of icons to be switched to Locked stars.
+
+	/** Sets the fills that should be displayed, requests only missing star widgets and applies the differences
+	 * @param NewStarFills Fill of each star, 0 is the locked star and 1 is the fully unlocked star
+	 */
+	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
+	void SetDesiredStarFills(const TArray<float>& NewStarFills);
+
+	/** Applies only the differences between desired and displayed star fills: returns surplus widgets and updates changed images and percentages */
+	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
+	void ApplyStarFills();
+
+	/** Updates star image icon to locked/unlocked and progress bar percentage
+	 * @param StarWidget Star widget to update
+	 * @param PreviousFill The fill displayed by the widget before, negative if unknown
+	 * @param NewFill The fill to display, 0 is the locked star
 	 */
 	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
-	void UpdateStarImages(const FPoolObjectData& CreatedData, float AmountOfUnlockedStars, float AmountOfLockedStars);
+	void UpdateStarWidget(class UPSStarWidget* StarWidget, float PreviousFill, float NewFill);
 
-	/** Updates Progress bar icon for unlocked icons
-	 * @param CreatedData Object received from Pool Manager which contains the reference to Start Widget 
-	 * @param NewProgressBarValue percentage completion
+	/** Shows the progression counter if the stars are compacted, otherwise hides it
+	 * @param AmountOfUnlockedPoints The amount of points achieved by player
+	 * @param MaxLevelPoints The amount of points required to unlock the level
+	 * @param bIsCompacted True if each star represents more than one point
 	 */
 	UFUNCTION(BlueprintCallable, Category= "C++", meta = (BlueprintProtected))
-	void UpdateStarProgressBarValue(const FPoolObjectData& CreatedData, float NewProgressBarValue);
+	void UpdateStarsCounter(float AmountOfUnlockedPoints, float MaxLevelPoints, bool bIsCompacted);
 };
@@ -5,15 +5,17 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Data/PSTypes.h"
+#include "Data/PSContext.h"
 #include "PSOverlayWidget.generated.h"
 
 /**
  * 
  * Overlay widget which is displayed for the locked/unlocked levels in the main menu
  * If level is locked overlay is displayed. Is unlocked - no overlay 
+ * Does not tick: the fade animation is played by the Slate active timer registered only while fading.
  */
-UCLASS()
-class PROGRESSIONSYSTEMRUNTIME_API UPSOverlayWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class PROGRESSIONSYSTEMRUNTIME_API UPSOverlayWidget : public UUserWidget, public TPSContextOwner<UPSOverlayWidget>
 {
 	GENERATED_BODY()
 
@@ -27,17 +29,28 @@ public:
 	void SetOverlayVisibility(ESlateVisibility VisibilitySlate, bool bShouldPlayFadeAnimation = false);
 
 protected:
-	/** overrides NativeTick to make the user widget tickable **/
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 	/** Event to execute when widget is ready */
 	virtual void NativeConstruct() override;
 
+	/** Is called when the widget is removed from the hierarchy, stops the fade animation if any */
+	virtual void NativeDestruct() override;
+
 	/**
 	* Play the overlay elements fade-in/fade-out animation.
-	* Uses the internal FadeCurveFloatInternal initialized in NativeConstruct
+	* Is called by the Slate active timer only while the fade is in progress, so the widget does not tick when idle.
+	* @return true if the animation is still playing, false if it's finished.
 	*/
 	UFUNCTION(BlueprintCallable, Category="C++", meta=(BlueprintProtected))
-	void TickPlayFadeOverlayAnimation();
+	bool TickPlayFadeOverlayAnimation();
+
+	/** Registers the Slate active timer that plays the fade animation, does nothing if it's already registered */
+	void RegisterFadeActiveTimer();
+
+	/** Unregisters the Slate active timer of the fade animation if it's registered */
+	void UnregisterFadeActiveTimer();
+
+	/** Is called by Slate every frame while the fade animation is in progress */
+	EActiveTimerReturnType OnFadeActiveTimer(double InCurrentTime, float InDeltaTime);
 
 	/**
 	* Sets the visibility of the background overlay and lock icon.
@@ -58,6 +71,13 @@ protected:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Should fade animation to be played"))
 	bool bShouldPlayFadeAnimationInternal = false;
 
+	/** The duration of the current fade animation, is cached on fade start to avoid data asset lookups every frame */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Fade Duration"))
+	float FadeDurationInternal = 0.f;
+
+	/** Handle of the active timer registered while the fade animation is in progress */
+	TWeakPtr<FActiveTimerHandle> FadeActiveTimerHandleInternal;
+
 	/** Current overlay widget fade state. */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Transient, AdvancedDisplay, Category = "C++", meta = (BlueprintProtected, DisplayName = "Overlay Widget Fade State"))
 	EPSOverlayWidgetFadeState OverlayWidgetFadeStateInternal = EPSOverlayWidgetFadeState::None;
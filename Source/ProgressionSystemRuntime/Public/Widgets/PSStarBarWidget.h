@@ -0,0 +1,69 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Components/Widget.h"
+#include "Styling/SlateBrush.h"
+#include "PSStarBarWidget.generated.h"
+
+/**
+ * Displays the whole progression star bar as a single native widget.
+ * Is a drop-in replacement for the Horizontal Box of star widgets in the progression menu:
+ * the widget count, layout cost and amount of widgets per bar do not depend on the amount of stars.
+ */
+UCLASS()
+class PROGRESSIONSYSTEMRUNTIME_API UPSStarBarWidget : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Sets the fill of each star, 0 is the locked star and 1 is the fully unlocked star. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SetStarFills(const TArray<float>& NewStarFills);
+
+	/** Returns the fill of each star. */
+	UFUNCTION(BlueprintPure, Category = "C++")
+	const FORCEINLINE TArray<float>& GetStarFills() const { return StarFillsInternal; }
+
+	/** Sets the star brushes to the ones which have no resource set by designer. */
+	UFUNCTION(BlueprintCallable, Category = "C++")
+	void SetDefaultStarBrushes(const FSlateBrush& EmptyStarBrush, const FSlateBrush& FullStarBrush);
+
+	/** Applies properties to the native widget. */
+	virtual void SynchronizeProperties() override;
+
+	/** Releases the native widget. */
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+#if WITH_EDITOR
+	/** Returns the category of this widget in the UMG palette. */
+	virtual const FText GetPaletteCategory() override;
+#endif
+
+protected:
+	/** Brush of the locked (empty) star. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Appearance", meta = (BlueprintProtected, DisplayName = "Empty Star Brush"))
+	FSlateBrush EmptyStarBrushInternal;
+
+	/** Brush of the unlocked (full) star, is clipped by the star fill. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Appearance", meta = (BlueprintProtected, DisplayName = "Full Star Brush"))
+	FSlateBrush FullStarBrushInternal;
+
+	/** Size of each star. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Appearance", meta = (BlueprintProtected, DisplayName = "Star Size"))
+	FVector2D StarSizeInternal = FVector2D(64.f, 64.f);
+
+	/** Horizontal space between stars. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Appearance", meta = (BlueprintProtected, DisplayName = "Star Spacing"))
+	float StarSpacingInternal = 0.f;
+
+	/** Fill of each star. */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient, Category = "C++", meta = (BlueprintProtected, DisplayName = "Star Fills"))
+	TArray<float> StarFillsInternal;
+
+	/** The native widget that paints all stars. */
+	TSharedPtr<class SPSStarBar> StarBarSlateInternal;
+
+	/** Creates the native widget. */
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+};
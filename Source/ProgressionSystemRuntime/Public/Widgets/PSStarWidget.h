@@ -22,6 +22,13 @@ public:
 	UFUNCTION()
 	void SetStarImage(UTexture2D* Image);
 
+	/**
+	* Updates the brush used for the star display, is expected to be the atlas region brush of the star icon.
+	* @param Brush The new brush to set for the star.
+	*/
+	UFUNCTION()
+	void SetStarBrush(const FSlateBrush& Brush);
+
 	/**
 	* Updates the star image progress bar to fill
 	* @param NewProgressValue new progress bar value to set.
@@ -29,12 +36,26 @@ public:
 	UFUNCTION()
 	void UpdateProgressionBarPercentage(float NewProgressValue);
 
+	/**
+	* Fills the star by the full star brush clipped to the fill, so partial stars are drawn from the same atlas as other stars.
+	* Falls back to the progress bar if the widget has no fill image.
+	* @param NewFill The fill of the star, 0 is the empty star and 1 is the full star.
+	* @param FullStarBrush The brush of the unlocked star.
+	*/
+	UFUNCTION()
+	void SetStarFill(float NewFill, const FSlateBrush& FullStarBrush);
+
 protected:
 	// Storing star image information for lock/unlocked icon
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidget))
 	TObjectPtr<class UImage> StarImageInternal = nullptr;
 
-	// Storing star progress bar icon to partially or fully fill progression 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidget))
+	// Storing star progress bar icon to partially or fully fill progression, is used only if there is no fill image
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidgetOptional))
 	TObjectPtr<class UProgressBar> StarProgressBarInternal = nullptr;
+
+	// Optional image above the star image that draws the filled part of the star, has to be left aligned and sized to its content.
+	// Unlike the progress bar, it doesn't clip, so all stars are batched
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Transient, Category = "C++", meta = (BlueprintProtected, BindWidgetOptional))
+	TObjectPtr<class UImage> StarFillImage = nullptr;
 };
@@ -0,0 +1,67 @@
+// Copyright (c) Valerii Rotermel & Yevhenii Selivanov
+
+#pragma once
+
+#include "Widgets/SLeafWidget.h"
+
+/**
+ * Native leaf widget that paints the whole progression star bar in a single OnPaint.
+ * Each star is drawn with the empty brush and covered with the full brush clipped by its fill value.
+ * @see UPSStarBarWidget to use it in UMG.
+ */
+class PROGRESSIONSYSTEMRUNTIME_API SPSStarBar : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPSStarBar)
+			: _EmptyStarBrush(nullptr)
+			, _FullStarBrush(nullptr)
+			, _StarSize(FVector2D(64.f, 64.f))
+			, _StarSpacing(0.f)
+		{
+		}
+
+		/** Brush of the locked (empty) star */
+		SLATE_ARGUMENT(const FSlateBrush*, EmptyStarBrush)
+		/** Brush of the unlocked (full) star, is clipped horizontally by the star fill */
+		SLATE_ARGUMENT(const FSlateBrush*, FullStarBrush)
+		/** Size of each star */
+		SLATE_ARGUMENT(FVector2D, StarSize)
+		/** Horizontal space between stars */
+		SLATE_ARGUMENT(float, StarSpacing)
+	SLATE_END_ARGS()
+
+	/** Constructs this widget with InArgs. */
+	void Construct(const FArguments& InArgs);
+
+	/** Sets the fill of each star, 0 is the empty star and 1 is the full star.
+	 * Invalidates the layout only if the amount of stars is changed, otherwise only the paint. */
+	void SetStarFills(TConstArrayView<float> NewStarFills);
+
+	/** Sets the brushes of the stars. */
+	void SetStarBrushes(const FSlateBrush* NewEmptyStarBrush, const FSlateBrush* NewFullStarBrush);
+
+	/** Sets the size of each star and the space between them. */
+	void SetStarLayout(const FVector2D& NewStarSize, float NewStarSpacing);
+
+	/** Paints all stars. */
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	/** Returns the size of all stars with spaces between them. */
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	/** Brush of the locked (empty) star. */
+	const FSlateBrush* EmptyStarBrush = nullptr;
+
+	/** Brush of the unlocked (full) star. */
+	const FSlateBrush* FullStarBrush = nullptr;
+
+	/** Size of each star. */
+	FVector2D StarSize = FVector2D::ZeroVector;
+
+	/** Horizontal space between stars. */
+	float StarSpacing = 0.f;
+
+	/** Fill of each star. */
+	TArray<float> StarFills;
+};